@@ -0,0 +1,149 @@
+#include "vgfx/asset.h"
+#include "vgfx/core.h"
+#include "vgfx/gl.h"
+#include "vgfx/os.h"
+#include "vgfx/render.h"
+
+// Draws a scene which cycles through more textures than a batch can bind, 
+// once with direct and once with multi-draw indirect submission.
+
+const usize WINDOW_WIDTH  = 800;
+const usize WINDOW_HEIGHT = 600;
+
+const usize TEXTURE_COUNT = 64;
+const usize QUAD_COUNT    = 50000;
+const usize QUAD_RUN      = 8;
+
+const usize WARMUP_FRAMES = 16;
+const usize BENCH_FRAMES  = 256;
+
+f64 bench_pipeline(VGFX_RD_Pipeline *pipeline, VGFX_AS_Shader *shader, 
+                   VGFX_AS_Texture *textures, mat4 vpm) {
+
+  f64 start = 0.0;
+
+  for (usize frame = 0; frame < WARMUP_FRAMES + BENCH_FRAMES; ++frame) {
+    if (frame == WARMUP_FRAMES) {
+      glFinish();
+      start = glfwGetTime();
+    }
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    vgfx_rd_pipeline_begin(pipeline, shader);
+
+    vgfx_gl_uniform_mat4fv("u_vpm", 1, false, &vpm[0][0]);
+
+    for (usize i = 0; i < QUAD_COUNT; ++i) {
+      vec3 pos = {(f32)(i % WINDOW_WIDTH), (f32)((i / WINDOW_WIDTH) % WINDOW_HEIGHT), 0.0f};
+      vec2 scl = {4.0f, 4.0f};
+
+      VGFX_AS_Texture *texture = &textures[(i / QUAD_RUN) % TEXTURE_COUNT];
+
+      vgfx_rd_send_texture(texture, pos, scl, NULL, (vec4){1.0f, 1.0f, 1.0f, 1.0f});
+    }
+
+    vgfx_rd_pipeline_flush();
+  }
+
+  glFinish();
+
+  return (glfwGetTime() - start) / BENCH_FRAMES;
+}
+
+int main(i32 argc, char *argv[]) {
+
+  VGFX_UNUSED(argc);
+  VGFX_UNUSED(argv);
+
+  VGFX_OS_WindowHandle win = vgfx_os_window_open(&(VGFX_OS_WindowDesc){
+      .title = "vgfx-bench-indirect",
+      .width = WINDOW_WIDTH,
+      .height = WINDOW_HEIGHT,
+      .vsync = false,
+      .resizable = false,
+      .decorated = true,
+      .visible = false,
+  });
+
+  VGFX_AS_AssetServer *asset_server = vgfx_as_asset_server_new();
+
+  VGFX_AS_AssetHandle direct_shader = vgfx_as_asset_server_load(asset_server, &(VGFX_AS_AssetDesc) {
+    .type = VGFX_ASSET_TYPE_SHADER,
+    .shader_vert_path = "res/shader/base.vert",
+    .shader_frag_path = "res/shader/base.frag",
+  });
+
+  // Single texel textures, the cost under test is the submission
+  VGFX_AS_Texture *textures = (VGFX_AS_Texture *)calloc(TEXTURE_COUNT, sizeof(VGFX_AS_Texture));
+
+  for (usize i = 0; i < TEXTURE_COUNT; ++i) {
+    u8 texel[4] = {(u8)(i * 4), (u8)(255 - i * 4), 128, 255};
+
+    glGenTextures(1, &textures[i].handle);
+    vgfx_gl_bind_texture(GL_TEXTURE_2D, textures[i].handle, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel);
+
+    textures[i].size[0]     = 1.0f;
+    textures[i].size[1]     = 1.0f;
+    textures[i].channel     = 4;
+    textures[i].target      = GL_TEXTURE_2D;
+    textures[i].uv_scale[0] = 1.0f;
+    textures[i].uv_scale[1] = 1.0f;
+  }
+
+  mat4 vpm;
+  glm_ortho(0.0f, WINDOW_WIDTH, 0.0f, WINDOW_HEIGHT, -1.0f, 1.0f, vpm);
+
+  printf("GL %u.%u, %u quads, %u textures, runs of %u\n", 
+         vgfx_gl_caps()->version / 10, vgfx_gl_caps()->version % 10, 
+         (u32)QUAD_COUNT, (u32)TEXTURE_COUNT, (u32)QUAD_RUN);
+
+  // Direct submission
+  VGFX_RD_Pipeline *direct = vgfx_rd_pipeline_new(asset_server, &(VGFX_RD_PipelineDesc){
+    .mode = VGFX_RD_PIPELINE_MODE_BATCH,
+    .stream_mode = VGFX_RD_STREAM_MODE_RING,
+    .submit_mode = VGFX_RD_SUBMIT_MODE_DIRECT,
+  });
+
+  f64 direct_time = bench_pipeline(direct, vgfx_as_shader(asset_server, direct_shader), textures, vpm);
+  printf("direct:   %8.3f ms/frame\n", direct_time * 1000.0);
+
+  vgfx_rd_piepline_free(direct);
+
+  // Indirect submission
+  if (vgfx_gl_caps()->tier >= VGFX_GL_TIER_INDIRECT) {
+    VGFX_AS_AssetHandle indirect_shader = vgfx_as_asset_server_load(asset_server, &(VGFX_AS_AssetDesc) {
+      .type = VGFX_ASSET_TYPE_SHADER,
+      .shader_vert_path = "res/shader/indirect.vert",
+      .shader_frag_path = "res/shader/indirect.frag",
+    });
+
+    VGFX_RD_Pipeline *indirect = vgfx_rd_pipeline_new(asset_server, &(VGFX_RD_PipelineDesc){
+      .mode = VGFX_RD_PIPELINE_MODE_BATCH,
+      .stream_mode = VGFX_RD_STREAM_MODE_RING,
+      .submit_mode = VGFX_RD_SUBMIT_MODE_INDIRECT,
+    });
+
+    f64 indirect_time = bench_pipeline(indirect, vgfx_as_shader(asset_server, indirect_shader), textures, vpm);
+    printf("indirect: %8.3f ms/frame (%.2fx)\n", 
+           indirect_time * 1000.0, direct_time / indirect_time);
+
+    vgfx_rd_piepline_free(indirect);
+  } else {
+    printf("indirect: not supported by the context\n");
+  }
+
+  for (usize i = 0; i < TEXTURE_COUNT; ++i) {
+    glDeleteTextures(1, &textures[i].handle);
+  }
+
+  free(textures);
+
+  vgfx_as_asset_server_free(asset_server);
+  vgfx_os_window_free(win);
+
+  return 0;
+}
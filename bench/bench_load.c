@@ -0,0 +1,131 @@
+#include "vgfx/asset.h"
+#include "vgfx/core.h"
+#include "vgfx/gl.h"
+#include "vgfx/os.h"
+
+#include <unistd.h>
+
+// Loads the same set of textures once on the calling thread and once
+// through the worker pool, the GL side is identical in both runs. Every
+// texture is its own file, the asset cache would share repeated paths.
+
+#define TEXTURE_COUNT 200
+
+const char *TEXTURE_PATHS[] = {
+  "res/bunny.png",
+  "res/dummy.png",
+};
+
+char s_paths[TEXTURE_COUNT][64];
+
+bool bench_setup(char *dir) {
+
+  if (!mkdtemp(dir)) {
+    return false;
+  }
+
+  for (usize i = 0; i < TEXTURE_COUNT; ++i) {
+    VGFX_FS_File file;
+    if (!vgfx_fs_map(TEXTURE_PATHS[i % 2], &file)) {
+      return false;
+    }
+
+    snprintf(s_paths[i], sizeof(s_paths[i]), "%s/%03u.png", dir, (u32)i);
+
+    FILE *out = fopen(s_paths[i], "wb");
+    if (out) {
+      fwrite(file.data, 1, file.size, out);
+      fclose(out);
+    }
+
+    vgfx_fs_unmap(&file);
+
+    if (!out) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void bench_cleanup(const char *dir) {
+
+  for (usize i = 0; i < TEXTURE_COUNT; ++i) {
+    if (s_paths[i][0]) {
+      unlink(s_paths[i]);
+    }
+  }
+
+  rmdir(dir);
+}
+
+f64 bench_load(bool async) {
+
+  VGFX_AS_AssetServer *asset_server = vgfx_as_asset_server_new();
+
+  glFinish();
+  f64 start = glfwGetTime();
+
+  for (usize i = 0; i < TEXTURE_COUNT; ++i) {
+    VGFX_AS_AssetDesc desc = {
+      .type = VGFX_ASSET_TYPE_TEXTURE,
+      .texture_path = s_paths[i],
+      .texture_filter = GL_NEAREST,
+      .texture_wrap = GL_REPEAT,
+    };
+
+    if (async) {
+      vgfx_as_asset_server_load_async(asset_server, &desc);
+    } else {
+      vgfx_as_asset_server_load(asset_server, &desc);
+    }
+  }
+
+  vgfx_as_asset_server_wait(asset_server);
+
+  glFinish();
+  f64 elapsed = glfwGetTime() - start;
+
+  vgfx_as_asset_server_free(asset_server);
+
+  return elapsed;
+}
+
+int main(i32 argc, char *argv[]) {
+
+  VGFX_UNUSED(argc);
+  VGFX_UNUSED(argv);
+
+  VGFX_OS_WindowHandle win = vgfx_os_window_open(&(VGFX_OS_WindowDesc){
+      .title = "vgfx-bench-load",
+      .width = 320,
+      .height = 240,
+      .vsync = false,
+      .resizable = false,
+      .decorated = true,
+      .visible = false,
+  });
+
+  char dir[] = "/tmp/vgfx-bench-load-XXXXXX";
+  if (!bench_setup(dir)) {
+    fprintf(stderr, "Failed to create the texture files.\n");
+
+    bench_cleanup(dir);
+    vgfx_os_window_free(win);
+    return 1;
+  }
+
+  printf("%u textures\n", (u32)TEXTURE_COUNT);
+
+  f64 sync_time = bench_load(false);
+  printf("sync:  %8.3f ms\n", sync_time * 1000.0);
+
+  f64 async_time = bench_load(true);
+  printf("async: %8.3f ms (%.2fx)\n", async_time * 1000.0, sync_time / async_time);
+
+  bench_cleanup(dir);
+
+  vgfx_os_window_free(win);
+
+  return 0;
+}
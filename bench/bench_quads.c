@@ -0,0 +1,113 @@
+#include "vgfx/core.h"
+#include "vgfx/render.h"
+
+#include <time.h>
+
+// Expands the same quads into vertex memory with every supported kernel.
+// Only the CPU side is measured, no GL context is needed.
+
+const usize QUAD_COUNT  = VGFX_RD_DEFAULT_QUAD_COUNT;
+const usize BENCH_RUNS  = 200;
+
+typedef struct Quad Quad;
+struct Quad {
+  f32 x, y, z, w, h;
+  f32 tex_x, tex_y, tex_w, tex_h;
+  u32 col;
+};
+
+f64 bench_now() {
+
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+f64 bench_kernel(VGFX_RD_Vertex *vertices, const VGFX_RD_QuadArrays *quads) {
+
+  const f32 uv_scale[2] = {1.0f, 1.0f};
+
+  // Warm up caches
+  _vgfx_rd_expand_quads(vertices, quads, 0, QUAD_COUNT, 0, uv_scale);
+
+  f64 start = bench_now();
+
+  for (usize i = 0; i < BENCH_RUNS; ++i) {
+    _vgfx_rd_expand_quads(vertices, quads, 0, QUAD_COUNT, (u8)i, uv_scale);
+  }
+
+  f64 elapsed = bench_now() - start;
+
+  return (f64)(QUAD_COUNT * BENCH_RUNS) / elapsed;
+}
+
+int main(i32 argc, char *argv[]) {
+
+  VGFX_UNUSED(argc);
+  VGFX_UNUSED(argv);
+
+  // Same data in both layouts
+  f32  *soa = (f32 *)malloc(QUAD_COUNT * 10 * sizeof(f32));
+  Quad *aos = (Quad *)malloc(QUAD_COUNT * sizeof(Quad));
+
+  for (usize i = 0; i < QUAD_COUNT; ++i) {
+    aos[i] = (Quad){
+      .x = (f32)(i % 800), .y = (f32)(i % 600), .z = 0.0f, .w = 32.0f, .h = 32.0f,
+      .tex_x = 0.0f, .tex_y = 0.0f, .tex_w = 0.5f, .tex_h = 0.5f,
+      .col = 0xFF000000 | (u32)i,
+    };
+
+    for (usize f = 0; f < 10; ++f) {
+      memcpy(&soa[f * QUAD_COUNT + i], (f32 *)&aos[i] + f, sizeof(f32));
+    }
+  }
+
+  const VGFX_RD_QuadArrays soa_quads = {
+    .x = &soa[0 * QUAD_COUNT], .y = &soa[1 * QUAD_COUNT], .z = &soa[2 * QUAD_COUNT],
+    .w = &soa[3 * QUAD_COUNT], .h = &soa[4 * QUAD_COUNT],
+    .tex_x = &soa[5 * QUAD_COUNT], .tex_y = &soa[6 * QUAD_COUNT],
+    .tex_w = &soa[7 * QUAD_COUNT], .tex_h = &soa[8 * QUAD_COUNT],
+    .col = (const u32 *)&soa[9 * QUAD_COUNT],
+    .stride = 0,
+  };
+
+  const VGFX_RD_QuadArrays aos_quads = {
+    .x = &aos->x, .y = &aos->y, .z = &aos->z, .w = &aos->w, .h = &aos->h,
+    .tex_x = &aos->tex_x, .tex_y = &aos->tex_y, .tex_w = &aos->tex_w, .tex_h = &aos->tex_h,
+    .col = &aos->col,
+    .stride = sizeof(Quad),
+  };
+
+  VGFX_RD_Vertex *vertices = (VGFX_RD_Vertex *)malloc(QUAD_COUNT * 4 * sizeof(VGFX_RD_Vertex));
+
+  printf("%u quads, %u runs\n", (u32)QUAD_COUNT, (u32)BENCH_RUNS);
+  printf("%-8s %14s %14s\n", "isa", "soa quads/s", "aos quads/s");
+
+  const VGFX_RD_SimdIsa isas[] = {
+    VGFX_RD_SIMD_ISA_SCALAR,
+    VGFX_RD_SIMD_ISA_SSE2,
+    VGFX_RD_SIMD_ISA_AVX2,
+    VGFX_RD_SIMD_ISA_NEON,
+  };
+
+  for (usize i = 0; i < sizeof(isas) / sizeof(isas[0]); ++i) {
+    if (!vgfx_rd_simd_isa_supported(isas[i])) {
+      printf("%-8s %14s %14s\n", vgfx_rd_simd_isa_name(isas[i]), "-", "-");
+      continue;
+    }
+
+    vgfx_rd_simd_isa_set(isas[i]);
+
+    f64 soa_rate = bench_kernel(vertices, &soa_quads);
+    f64 aos_rate = bench_kernel(vertices, &aos_quads);
+
+    printf("%-8s %14.3e %14.3e\n", vgfx_rd_simd_isa_name(isas[i]), soa_rate, aos_rate);
+  }
+
+  free(vertices);
+  free(aos);
+  free(soa);
+
+  return 0;
+}
@@ -0,0 +1,25 @@
+#version 330 core
+out vec4 frag_color;
+
+flat in int v_texture;
+in vec2 v_tex;
+in vec4 v_col;
+
+uniform float u_time;
+uniform sampler2DArray u_texture_array;
+
+void main() {
+  float temp = u_time;
+
+  int layer = v_texture;
+
+  if (layer < 0) {
+    frag_color = v_col;
+  } else {
+    frag_color = texture(u_texture_array, vec3(v_tex, float(layer))) * v_col;
+  }
+
+  if (frag_color.a == 0) {
+    discard;
+  }
+}
@@ -2,7 +2,7 @@
 out vec4 frag_color;
 
 in float v_shader;
-in float v_texture;
+flat in int v_texture;
 in vec2 v_tex;
 in vec4 v_col;
 
@@ -13,7 +13,7 @@ void main() {
   float temp = u_time;
 
   int shader = int(v_shader);
-  int index = int(v_texture);
+  int index = v_texture;
   
   vec4 tex_color = texture(u_texture[index], v_tex);
     
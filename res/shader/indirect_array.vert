@@ -0,0 +1,23 @@
+#version 330 core
+#extension GL_ARB_shader_draw_parameters : require
+layout (location = 0) in vec3 a_pos;
+layout (location = 1) in vec2 a_tex;
+layout (location = 2) in vec4 a_col;
+layout (location = 3) in uint a_texture;
+
+uniform mat4 u_vpm;
+uniform int u_texture_base[32];
+
+flat out int v_page;
+flat out int v_texture;
+out vec2 v_tex;
+out vec4 v_col;
+
+void main() {
+  gl_Position = u_vpm * vec4(a_pos, 1.0);
+
+  v_page = u_texture_base[gl_DrawIDARB];
+  v_texture = (a_texture == 255u) ? -1 : int(a_texture);
+  v_tex = a_tex;
+  v_col = a_col;
+}
@@ -0,0 +1,35 @@
+#version 330 core
+layout (location = 0) in vec3 a_pos;
+layout (location = 1) in vec2 a_size;
+layout (location = 2) in float a_rot;
+layout (location = 3) in vec4 a_tex;
+layout (location = 4) in vec4 a_col;
+layout (location = 5) in uint a_texture;
+
+uniform mat4 u_vpm;
+
+flat out int v_texture;
+out vec2 v_tex;
+out vec4 v_col;
+
+const vec2 c_corner[6] = vec2[6](
+  vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0),
+  vec2(1.0, 0.0), vec2(0.0, 0.0), vec2(0.0, 1.0)
+);
+
+void main() {
+  vec2 corner = c_corner[gl_VertexID];
+
+  float c = cos(a_rot);
+  float s = sin(a_rot);
+
+  vec2 local = (corner - 0.5) * a_size;
+  vec2 pos = a_pos.xy + a_size * 0.5 + vec2(local.x * c - local.y * s,
+                                            local.x * s + local.y * c);
+
+  gl_Position = u_vpm * vec4(pos, a_pos.z, 1.0);
+
+  v_texture = (a_texture == 255u) ? -1 : int(a_texture);
+  v_tex = vec2(a_tex.x + corner.x * a_tex.z, a_tex.y + (1.0 - corner.y) * a_tex.w);
+  v_col = a_col;
+}
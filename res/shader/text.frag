@@ -1,7 +1,7 @@
 #version 330 core
 out vec4 frag_color;
 
-in float v_texture;
+flat in int v_texture;
 in vec2 v_tex;
 in vec4 v_col;
 
@@ -11,7 +11,7 @@ uniform sampler2D u_texture[16];
 void main() {
   float temp = u_time;
 
-  int index = int(v_texture);
+  int index = v_texture;
     
   vec4 tex_color = texture(u_texture[index], v_tex);
 
@@ -13,12 +13,16 @@ const char *WINDOW_TITLE = "vgfx";
 
 const char *BASE_FRAG_SHADER_PATH = "res/shader/base.frag";
 const char *BASE_VERT_SHADER_PATH = "res/shader/base.vert";
+const char *OPAQUE_FRAG_SHADER_PATH = "res/shader/opaque.frag";
 const char *TEXT_FRAG_SHADER_PATH = "res/shader/text.frag";
 const char *TEXT_VERT_SHADER_PATH = "res/shader/text.vert";
+const char *SPRITE_VERT_SHADER_PATH = "res/shader/sprite.vert";
 
 const char *TEST_FONT_PATH = "res/font/JetBrainsMono-Regular.ttf";
 const char *TEST_TEXTURE_PATH = "res/bunny.png";
 
+const char *ASSET_ARCHIVE_PATH = "res/assets.vpak";
+
 static VGFX_RD_Camera *s_camera = NULL;
 
 typedef struct Object {
@@ -82,16 +86,20 @@ int main(i32 argc, char *argv[]) {
   // Asset Server
   VGFX_AS_AssetServer *asset_server = vgfx_as_asset_server_new();
 
-  // Load texture
-  VGFX_AS_Asset *texture = vgfx_as_asset_server_load(asset_server, &(VGFX_AS_AssetDesc){
+  // Baked by the `vgfx_assets` target, loose files are used when it's missing
+  if (vgfx_fs_exists(ASSET_ARCHIVE_PATH)) {
+    vgfx_as_asset_server_mount(asset_server, ASSET_ARCHIVE_PATH);
+  }
+
+  // Decode the texture and font on workers while shaders compile
+  VGFX_AS_AssetHandle texture = vgfx_as_asset_server_load_async(asset_server, &(VGFX_AS_AssetDesc){
     .type = VGFX_ASSET_TYPE_TEXTURE,
     .texture_path = TEST_TEXTURE_PATH,
     .texture_filter = GL_NEAREST,
     .texture_wrap = GL_REPEAT,
   });
 
-  // Load font
-  VGFX_AS_Asset *font = vgfx_as_asset_server_load(asset_server, &(VGFX_AS_AssetDesc){
+  VGFX_AS_AssetHandle font = vgfx_as_asset_server_load_async(asset_server, &(VGFX_AS_AssetDesc){
     .type = VGFX_ASSET_TYPE_FONT,
     .font_path = TEST_FONT_PATH,
     .font_filter = GL_LINEAR,
@@ -101,20 +109,46 @@ int main(i32 argc, char *argv[]) {
   });
 
   // Load shader programs
-  VGFX_AS_Asset *base_shader = vgfx_as_asset_server_load(asset_server, &(VGFX_AS_AssetDesc) {
+  VGFX_AS_AssetHandle base_shader = vgfx_as_asset_server_load(asset_server, &(VGFX_AS_AssetDesc) {
     .type = VGFX_ASSET_TYPE_SHADER,
-    .shader_vert_path = BASE_VERT_SHADER_PATH,
+    .shader_vert_path = SPRITE_VERT_SHADER_PATH,
     .shader_frag_path = BASE_FRAG_SHADER_PATH,
   });
 
-  VGFX_AS_Asset *text_shader = vgfx_as_asset_server_load(asset_server, &(VGFX_AS_AssetDesc) {
+  VGFX_AS_AssetHandle opaque_shader = vgfx_as_asset_server_load(asset_server, &(VGFX_AS_AssetDesc) {
     .type = VGFX_ASSET_TYPE_SHADER,
-    .shader_vert_path = TEXT_VERT_SHADER_PATH,
+    .shader_vert_path = SPRITE_VERT_SHADER_PATH,
+    .shader_frag_path = OPAQUE_FRAG_SHADER_PATH,
+  });
+
+  VGFX_AS_AssetHandle text_shader = vgfx_as_asset_server_load(asset_server, &(VGFX_AS_AssetDesc) {
+    .type = VGFX_ASSET_TYPE_SHADER,
+    .shader_vert_path = SPRITE_VERT_SHADER_PATH,
     .shader_frag_path = TEXT_FRAG_SHADER_PATH,
   });
 
+  vgfx_as_asset_server_wait(asset_server);
+
+  VGFX_ASSERT(vgfx_as_asset_state(asset_server, texture) == VGFX_ASSET_STATE_READY, "Failed to load texture.");
+  VGFX_ASSERT(vgfx_as_asset_state(asset_server, font) == VGFX_ASSET_STATE_READY, "Failed to load font.");
+
+  // Resolve per-frame uniforms once
+  VGFX_AS_Shader *bsh = vgfx_as_shader(asset_server, base_shader);
+  VGFX_AS_Shader *tsh = vgfx_as_shader(asset_server, text_shader);
+  VGFX_AS_Shader *osh = vgfx_as_shader(asset_server, opaque_shader);
+
+  const VGFX_AS_Uniform *base_time = vgfx_as_shader_uniform(bsh, "u_time");
+  const VGFX_AS_Uniform *base_vpm  = vgfx_as_shader_uniform(bsh, "u_vpm");
+  const VGFX_AS_Uniform *text_time = vgfx_as_shader_uniform(tsh, "u_time");
+  const VGFX_AS_Uniform *text_vpm  = vgfx_as_shader_uniform(tsh, "u_vpm");
+
   // Create pipeline
-  VGFX_RD_Pipeline *pipeline = vgfx_rd_pipeline_new(asset_server);
+  VGFX_RD_Pipeline *pipeline = vgfx_rd_pipeline_new(asset_server, &(VGFX_RD_PipelineDesc){
+    .mode = VGFX_RD_PIPELINE_MODE_INSTANCED,
+    .stream_mode = VGFX_RD_STREAM_MODE_RING,
+    .sort_mode = VGFX_RD_SORT_MODE_DEPTH,
+    .gpu_timing = true,
+  });
 
   // Setup camera
   s_camera = vgfx_rd_camera_new(&(VGFX_RD_CameraDesc) {
@@ -137,6 +171,7 @@ int main(i32 argc, char *argv[]) {
 
   bool run = true;
   bool spawn = false;
+  bool stats = false;
 
   f32 ft[10] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
   usize ft_counter = 0;
@@ -149,12 +184,17 @@ int main(i32 argc, char *argv[]) {
   volatile f64 frm_timer = 0.0f;
   volatile f64 dt, last_frame;
   while (run) {
+    VGFX_PROFILE_BEGIN(frame);
+
     // Time and delta time
     f64 time = glfwGetTime();
 
     dt = time - last_frame;
     last_frame = time;
 
+    // Stream pending texture uploads within the frame budget
+    vgfx_as_asset_server_update(asset_server);
+
     fps_timer += dt;
     fps_counter += 1;
     if (fps_timer > 1.0f) {
@@ -164,6 +204,22 @@ int main(i32 argc, char *argv[]) {
 
       printf("FPS: %u\n", fps);
 
+      // Per-pass timings and state counters follow the stats overlay
+      if (stats) {
+        usize pass_count;
+        const VGFX_RD_PassStats *passes = vgfx_rd_pipeline_pass_stats(pipeline, &pass_count);
+
+        for (usize i = 0; i < pass_count; ++i) {
+          printf("  %-8s CPU: %.2f ms, GPU: %.2f ms, PRIM: %llu, FRAG: %llu\n", 
+                 passes[i].name, passes[i].cpu_time, passes[i].gpu_time, 
+                 (unsigned long long)passes[i].primitives, 
+                 (unsigned long long)passes[i].fragments);
+        }
+
+        const VGFX_GL_StateStats *gl_stats = vgfx_gl_state_stats();
+        printf("  GL state %zu/%zu elided\n", gl_stats->elided, gl_stats->calls);
+      }
+
       vstd_string_free(&cnt_str);
       cnt_str = vstd_string_format("CNT: %u", objs.len);
     }
@@ -198,6 +254,10 @@ int main(i32 argc, char *argv[]) {
         if (_$iter->key_code == VGFX_IN_KEY_ENTER) {
           spawn = true;
         }
+
+        if (_$iter->key_code == VGFX_IN_KEY_TAB) {
+          stats = !stats;
+        }
       }
     });
 
@@ -247,13 +307,14 @@ int main(i32 argc, char *argv[]) {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // Render the scene
-    vgfx_rd_pipeline_begin(pipeline, base_shader);
+    vgfx_rd_pipeline_begin_pass(pipeline, bsh, "sprites");
+    vgfx_rd_set_camera(s_camera);
+    vgfx_rd_set_opaque_shader(osh);
 
-    vgfx_gl_uniform_fv("u_time", 1, (f32[1]){(f32)time});
-    vgfx_gl_uniform_mat4fv("u_vpm", 1, false, &vpm[0][0]);
+    vgfx_gl_uniform_set_fv(base_time, 1, (f32[1]){(f32)time});
+    vgfx_gl_uniform_set_matfv(base_vpm, 1, false, &vpm[0][0]);
 
-    VGFX_AS_Texture *th;
-    VGFX_ASSET_DEBUG_CAST(texture, VGFX_ASSET_TYPE_TEXTURE, th);
+    VGFX_AS_Texture *th = vgfx_as_texture(asset_server, texture);
 
     vstd_vector_iter(Object, objs, {
       vgfx_rd_send_texture(th, _$iter->pos, _$iter->scl, NULL, _$iter->col);
@@ -261,13 +322,12 @@ int main(i32 argc, char *argv[]) {
 
     vgfx_rd_pipeline_flush();
 
-    vgfx_rd_pipeline_begin(pipeline, text_shader);
+    vgfx_rd_pipeline_begin_pass(pipeline, tsh, "text");
 
-    vgfx_gl_uniform_fv("u_time", 1, (f32[1]){(f32)time});
-    vgfx_gl_uniform_mat4fv("u_vpm", 1, false, &vpm[0][0]);
+    vgfx_gl_uniform_set_fv(text_time, 1, (f32[1]){(f32)time});
+    vgfx_gl_uniform_set_matfv(text_vpm, 1, false, &vpm[0][0]);
 
-    VGFX_AS_Font *fh;
-    VGFX_ASSET_DEBUG_CAST(font, VGFX_ASSET_TYPE_FONT, fh);
+    VGFX_AS_Font *fh = vgfx_as_font(asset_server, font);
 
     vec2s tsize0 = vgfx_rd_font_render_size(fh, frm_str.ptr, true);
     vec2s tsize1 = vgfx_rd_font_render_size(fh, cnt_str.ptr, true);
@@ -284,12 +344,29 @@ int main(i32 argc, char *argv[]) {
       (vec4){1.0f, 1.0f, 1.0f, 1.0f}
     );
 
+    if (stats) {
+      vgfx_rd_send_stats(
+        fh, vgfx_rd_pipeline_stats(pipeline, VGFX_RD_STATS_SCOPE_FRAME), 
+        (vec3){0.0f, (f32)WINDOW_HEIGHT - (tsize0.y + tsize1.y), 100.0f}, 
+        (vec4){1.0f, 1.0f, 1.0f, 1.0f}
+      );
+    }
+
     vgfx_rd_pipeline_flush();
 
+    vgfx_rd_pipeline_end_frame(pipeline);
+
     vgfx_os_window_swap_buffers(win);
     vgfx_os_poll_events();
+
+    VGFX_PROFILE_END(frame);
   }
 
+#if VGFX_ENABLE_PROFILER
+  // Open in chrome://tracing or Perfetto
+  vgfx_profiler_dump("vgfx_trace.json");
+#endif
+
   // Delete vectors
   vstd_vector_free(Object, (&objs));
 
@@ -302,6 +379,7 @@ int main(i32 argc, char *argv[]) {
   // Free the vgfx
   vgfx_as_asset_server_free(asset_server);
   vgfx_os_window_free(win);
+  vgfx_profiler_free();
 
   return 0;
 }
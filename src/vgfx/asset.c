@@ -4,6 +4,8 @@
 #include <freetype/freetype.h>
 #include <stb/stb_image.h>
 
+#include <unistd.h>
+
 // =============================================
 //
 //
@@ -16,15 +18,18 @@ VGFX_AS_AssetServer *
 vgfx_as_asset_server_new() {
 
   VGFX_AS_AssetServer *as =
-      (VGFX_AS_AssetServer *)malloc(sizeof(VGFX_AS_AssetServer));
+      (VGFX_AS_AssetServer *)calloc(1, sizeof(VGFX_AS_AssetServer));
 
-  as->assets = vstd_map_new(
-        VGFX_AS_AssetType, VSTD_Vector(VGFX_AS_Asset *), vstd_map_condition_isize);
+  _vgfx_as_slots_init(&as->slots[VGFX_ASSET_TYPE_TEXTURE], sizeof(VGFX_AS_Texture));
+  _vgfx_as_slots_init(&as->slots[VGFX_ASSET_TYPE_FONT], sizeof(VGFX_AS_Font));
+  _vgfx_as_slots_init(&as->slots[VGFX_ASSET_TYPE_SHADER], sizeof(VGFX_AS_Shader));
 
-  for (usize i = VGFX_ASSET_TYPE_UNKNOWN + 1; i < VGFX_ASSET_TYPE_LAST; ++i) {
-    vstd_map_set(VGFX_AS_AssetType, VSTD_Vector(VGFX_AS_Asset *), as->assets, i,
-                 (vstd_vector_new(VGFX_AS_Asset *)));
-  }
+  as->texture_arrays = vstd_vector_new(VGFX_AS_TextureArray);
+  as->archives       = vstd_vector_new(_VGFX_AS_Archive);
+
+  _vgfx_as_upload_init(&as->upload);
+  _vgfx_as_workers_init(&as->workers);
+  _vgfx_as_cache_init(&as->cache);
 
   return as;
 }
@@ -34,105 +39,372 @@ vgfx_as_asset_server_free(VGFX_AS_AssetServer *as) {
 
   VGFX_ASSERT_NON_NULL(as);
 
-  // Free assets
-  for (usize i = 0; i < as->assets.keys.len; ++i) {
-    VSTD_Vector(VGFX_AS_Asset *) *vec =
-        &vstd_vector_get(VSTD_Vector(VGFX_AS_Asset *), as->assets.vals, i);
+  // Outstanding decodes are dropped, their assets stay in the loading state
+  _vgfx_as_workers_free(&as->workers);
+
+  // Unfinished uploads hand their textures back before assets are freed
+  _vgfx_as_upload_free(as);
 
-    vstd_vector_iter(VGFX_AS_Asset *, (*vec), {
-      VGFX_AS_Asset *asset = (*_$iter);
+  // Free assets, outstanding references are ignored
+  for (usize type = VGFX_ASSET_TYPE_UNKNOWN + 1; type < VGFX_ASSET_TYPE_LAST; ++type) {
+    _VGFX_AS_SlotMap *slots = &as->slots[type];
 
-      // Validate asset type
-      i32 type = asset->type;
-      if (type < 0 || type >= VGFX_ASSET_TYPE_LAST) {
-        type = VGFX_ASSET_TYPE_UNKNOWN;
+    for (u32 i = 0; i < slots->cap; ++i) {
+      VGFX_AS_Asset *asset = _vgfx_as_slots_asset(slots, i);
+
+      if (!asset->alive) {
+        continue;
       }
 
-      // Free asset handle
-      switch (type) {
-      case VGFX_ASSET_TYPE_UNKNOWN:
-        VGFX_ABORT("Failed to free asset, unknown asset type `%d`.",
-                   asset->type);
-        break;
-      case VGFX_ASSET_TYPE_TEXTURE:
-        _vgfx_as_free_texture(asset->handle);
-        break;
-      case VGFX_ASSET_TYPE_FONT:
-        _vgfx_as_free_font(asset->handle);
-        break;
-      case VGFX_ASSET_TYPE_SHADER:
-        _vgfx_as_free_shader(asset->handle);
-        break;
+      if (asset->state == VGFX_ASSET_STATE_READY) {
+        _vgfx_as_asset_free_value(as, type, _vgfx_as_slots_value(slots, i));
       }
 
-      // Free asset
-      free(asset);
-    });
+      vstd_string_free(&asset->_key);
+    }
+
+    _vgfx_as_slots_free(slots);
   }
 
-  // Free assets map
-  vstd_map_free(VGFX_AS_AssetType, VSTD_Vector(VGFX_AS_Asset *), as->assets);
+  _vgfx_as_cache_free(&as->cache);
+
+  // Free shared texture arrays
+  vstd_vector_iter(VGFX_AS_TextureArray, as->texture_arrays, {
+    _vgfx_as_free_texture_array(_$iter);
+  });
+
+  vstd_vector_free(VGFX_AS_TextureArray, (&as->texture_arrays));
+
+  // Unmap archives last, nothing borrows from them anymore
+  vstd_vector_iter(_VGFX_AS_Archive, as->archives, {
+    vgfx_fs_unmap(&_$iter->file);
+  });
+
+  vstd_vector_free(_VGFX_AS_Archive, (&as->archives));
+
+  free(as);
 }
 
-VGFX_AS_Asset *
+VGFX_AS_AssetHandle 
 vgfx_as_asset_server_load(VGFX_AS_AssetServer *as, VGFX_AS_AssetDesc *desc) {
 
   VGFX_ASSERT_NON_NULL(as);
   VGFX_ASSERT_NON_NULL(desc);
 
+  bool cached;
+  VGFX_AS_AssetHandle handle = _vgfx_as_asset_acquire(as, desc, &cached);
+
+  if (cached) {
+    // An async load of the same key may still be in flight
+    while (vgfx_as_asset_state(as, handle) == VGFX_ASSET_STATE_LOADING) {
+      _vgfx_as_workers_finish(as, _vgfx_as_workers_drain(&as->workers, true));
+    }
+
+    VGFX_ASSERT(vgfx_as_asset_state(as, handle) == VGFX_ASSET_STATE_READY, 
+                "Failed to load shared asset of type `%d`.", desc->type);
+
+    return handle;
+  }
+
+  // Decode and create on the calling thread, archived payloads skip decoding
+  _VGFX_AS_Decoded decoded;
+  if (!_vgfx_as_archive_decode(as, desc, &decoded) && !_vgfx_as_decode(desc, &decoded)) {
+    VGFX_ABORT("Failed to decode asset of type `%d`.", desc->type);
+  }
+
+  if (!_vgfx_as_load(as, handle, desc, &decoded)) {
+    VGFX_ABORT("Failed to create asset of type `%d`.", desc->type);
+  }
+
+  _vgfx_as_texture_arrays_commit(as);
+
+  _vgfx_as_asset_get(as, handle)->state = VGFX_ASSET_STATE_READY;
+
+  return handle;
+}
+
+VGFX_AS_AssetHandle 
+vgfx_as_asset_server_load_async(VGFX_AS_AssetServer *as, VGFX_AS_AssetDesc *desc) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(desc);
+
+  bool cached;
+  VGFX_AS_AssetHandle handle = _vgfx_as_asset_acquire(as, desc, &cached);
+
+  if (cached) {
+    return handle;
+  }
+
+  // Archived payloads have nothing to decode, they are created right away
+  _VGFX_AS_Decoded decoded;
+  if (_vgfx_as_archive_decode(as, desc, &decoded)) {
+    const bool loaded = _vgfx_as_load(as, handle, desc, &decoded);
+
+    _vgfx_as_texture_arrays_commit(as);
+
+    _vgfx_as_asset_get(as, handle)->state = (loaded) ? VGFX_ASSET_STATE_READY 
+                                                     : VGFX_ASSET_STATE_FAILED;
+
+    if (!loaded) {
+      _vgfx_as_cache_remove(as, handle);
+    }
+
+    return handle;
+  }
+
+  // Decoded on a worker, created by the next update after it finishes
+  _vgfx_as_workers_submit(&as->workers, _vgfx_as_job_new(handle, desc));
+
+  return handle;
+}
+
+void 
+vgfx_as_asset_server_wait(VGFX_AS_AssetServer *as) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  VGFX_PROFILE_BEGIN(vgfx_as_asset_server_wait);
+
+  while (as->workers.pending) {
+    _vgfx_as_workers_finish(as, _vgfx_as_workers_drain(&as->workers, true));
+  }
+
+  VGFX_PROFILE_END(vgfx_as_asset_server_wait);
+}
+
+bool 
+vgfx_as_asset_server_mount(VGFX_AS_AssetServer *as, const char *path) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(path);
+
+  _VGFX_AS_Archive archive;
+  if (!_vgfx_as_archive_open(path, &archive)) {
+    return false;
+  }
+
+  vstd_vector_push(_VGFX_AS_Archive, (&as->archives), archive);
+
+  return true;
+}
+
+void 
+vgfx_as_asset_server_release(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  VGFX_AS_Asset *asset = _vgfx_as_asset_get(as, handle);
+
+  VGFX_ASSERT(asset, "Released a stale asset handle, `%08x`.", handle);
+  VGFX_ASSERT(asset->refs, "Asset was released more often than it was loaded.");
+
+  asset->refs -= 1;
+  if (asset->refs) {
+    return;
+  }
+
+  // Later loads of the same key start over
+  _vgfx_as_cache_remove(as, handle);
+
+  // A pending decode still owns the slot, finishing it frees it
+  if (asset->state != VGFX_ASSET_STATE_LOADING) {
+    _vgfx_as_asset_free(as, handle);
+  }
+}
+
+void 
+vgfx_as_asset_server_update(VGFX_AS_AssetServer *as) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  VGFX_PROFILE_BEGIN(vgfx_as_asset_server_update);
+
+  // Create GL objects for everything the workers finished
+  if (as->workers.pending) {
+    _vgfx_as_workers_finish(as, _vgfx_as_workers_drain(&as->workers, false));
+  }
+
+  // Stage rows until the budget runs out or the ring is still in flight
+  usize budget = as->upload.budget;
+  while (budget && _vgfx_as_upload_step(as, &budget)) {
+  }
+
+  VGFX_PROFILE_END(vgfx_as_asset_server_update);
+}
+
+void 
+vgfx_as_asset_server_set_upload_budget(VGFX_AS_AssetServer *as, usize bytes) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_ZERO(bytes);
+
+  as->upload.budget = bytes;
+}
+
+VGFX_AS_AssetState 
+vgfx_as_asset_state(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  VGFX_AS_Asset *asset = _vgfx_as_asset_get(as, handle);
+
+  return (asset) ? asset->state : VGFX_ASSET_STATE_INVALID;
+}
+
+VGFX_AS_AssetHandle 
+_vgfx_as_asset_acquire(VGFX_AS_AssetServer *as, VGFX_AS_AssetDesc *desc, bool *cached) {
+
   // Validate asset type
   VGFX_AS_AssetType type = desc->type;
-  if (type < 0 || type >= VGFX_ASSET_TYPE_LAST) {
-    type = VGFX_ASSET_TYPE_UNKNOWN;
+  if (type <= VGFX_ASSET_TYPE_UNKNOWN || type >= VGFX_ASSET_TYPE_LAST) {
+    VGFX_ABORT("Failed to load asset, unknown asset type `%d`.", desc->type);
+  }
+
+  // Share the asset loaded with the same parameters
+  VSTD_String key  = _vgfx_as_cache_key(desc);
+  const u64   hash = _vgfx_as_cache_hash(key.ptr);
+
+  VGFX_AS_AssetHandle handle = _vgfx_as_cache_find(as, key.ptr, hash);
+
+  *cached = (handle != VGFX_AS_INVALID_ASSET);
+  if (*cached) {
+    vstd_string_free(&key);
+
+    _vgfx_as_asset_get(as, handle)->refs += 1;
+    return handle;
+  }
+
+  // Create asset
+  const u32 index = _vgfx_as_slots_alloc(&as->slots[type]);
+
+  VGFX_AS_Asset *asset = _vgfx_as_slots_asset(&as->slots[type], index);
+
+  asset->state = VGFX_ASSET_STATE_LOADING;
+  asset->refs  = 1;
+  asset->_key  = key;
+  asset->_hash = hash;
+  asset->_next = VGFX_AS_INVALID_ASSET;
+
+  handle = VGFX_AS_HANDLE_MAKE(type, asset->generation, index);
+
+  _vgfx_as_cache_insert(as, handle);
+
+  return handle;
+}
+
+void 
+_vgfx_as_asset_free(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  const VGFX_AS_AssetType type = VGFX_AS_HANDLE_TYPE(handle);
+
+  VGFX_AS_Asset *asset = _vgfx_as_asset_get(as, handle);
+  VGFX_ASSERT(asset, "Freed a stale asset handle, `%08x`.", handle);
+
+  if (asset->state == VGFX_ASSET_STATE_READY) {
+    // A streaming texture hands its real handle back before it is deleted
+    if (type == VGFX_ASSET_TYPE_TEXTURE && 
+        !((VGFX_AS_Texture *)_vgfx_as_asset_value(as, handle))->ready) {
+      _vgfx_as_upload_cancel(as, handle);
+    }
+
+    _vgfx_as_asset_free_value(as, type, _vgfx_as_asset_value(as, handle));
   }
 
-  // Create asset's hanlde
-  void *handle = NULL;
+  vstd_string_free(&asset->_key);
+
+  // Return the slot, its generation moves on
+  _vgfx_as_slots_release(&as->slots[type], VGFX_AS_HANDLE_INDEX(handle));
+}
+
+void 
+_vgfx_as_asset_free_value(VGFX_AS_AssetServer *as, VGFX_AS_AssetType type, void *value) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(value);
+
   switch (type) {
-  case VGFX_ASSET_TYPE_UNKNOWN:
-    VGFX_ABORT("Failed to load asset, unknown asset type `%d`.", desc->type);
-    break;
   case VGFX_ASSET_TYPE_TEXTURE:
-    handle = _vgfx_as_load_texture(desc);
+    _vgfx_as_free_texture(as, value);
     break;
   case VGFX_ASSET_TYPE_FONT:
-    handle = _vgfx_as_load_font(desc);
+    _vgfx_as_free_font(value);
     break;
   case VGFX_ASSET_TYPE_SHADER:
-    handle = _vgfx_as_load_shader(desc);
+    _vgfx_as_free_shader(value);
     break;
   default:
-    VGFX_ABORT("Load function for this type is missing.");
+    VGFX_ABORT("Failed to free asset, unknown asset type `%d`.", type);
     break;
   }
+}
 
-  // Create asset
-  VGFX_AS_Asset *asset = (VGFX_AS_Asset *)malloc(sizeof(VGFX_AS_Asset));
-  *asset = (VGFX_AS_Asset){
-      .type = type,
-      .handle = handle,
-  };
+VGFX_AS_Asset *
+_vgfx_as_asset_get(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle) {
 
-  // Set asset handle
-  VSTD_Vector(VGFX_AS_Asset *) *vec = NULL;
-  vstd_map_get(VGFX_AS_AssetType, VSTD_Vector(VGFX_AS_Asset *), as->assets,
-               type, vec);
+  const u32 type  = VGFX_AS_HANDLE_TYPE(handle);
+  const u32 index = VGFX_AS_HANDLE_INDEX(handle);
 
-  VGFX_ASSERT(vec, "AssetServer for this asset type is NULL.");
+  if (type <= VGFX_ASSET_TYPE_UNKNOWN || type >= VGFX_ASSET_TYPE_LAST) {
+    return NULL;
+  }
+
+  _VGFX_AS_SlotMap *slots = &as->slots[type];
+  if (index >= slots->cap) {
+    return NULL;
+  }
 
-  vstd_vector_push(VGFX_AS_Asset *, vec, asset);
+  VGFX_AS_Asset *asset = _vgfx_as_slots_asset(slots, index);
+  if (!asset->alive || 
+      (asset->generation & VGFX_AS_HANDLE_GENERATION_MASK) != VGFX_AS_HANDLE_GENERATION(handle)) {
+    return NULL;
+  }
 
   return asset;
 }
 
-void 
-_vgfx_as_validate_asset_path(const char *path) {
+void *
+_vgfx_as_asset_value(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle) {
+
+  if (!_vgfx_as_asset_get(as, handle)) {
+    return NULL;
+  }
+
+  return _vgfx_as_slots_value(&as->slots[VGFX_AS_HANDLE_TYPE(handle)], 
+                              VGFX_AS_HANDLE_INDEX(handle));
+}
+
+void *
+_vgfx_as_asset_resolve(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, 
+                       VGFX_AS_AssetType type) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  if (VGFX_AS_HANDLE_TYPE(handle) != (u32)type) {
+    VGFX_DEBUG_ASSERT(!handle, "Asset handle `%08x` isn't of type `%d`.", handle, type);
+    return NULL;
+  }
+
+  // Only ready assets have a value worth reading
+  VGFX_AS_Asset *asset = _vgfx_as_asset_get(as, handle);
+  if (!asset || asset->state != VGFX_ASSET_STATE_READY) {
+    return NULL;
+  }
+
+  return _vgfx_as_slots_value(&as->slots[type], VGFX_AS_HANDLE_INDEX(handle));
+}
 
-  VSTD_String tmp = vstd_fs_read_file(path);
+bool 
+_vgfx_as_validate_asset_path(const char *path) {
 
-  VGFX_ASSERT(tmp.ptr, "Invalid asset path, `%s`.\n", path);
+  if (!vgfx_fs_exists(path)) {
+    VGFX_DEBUG_WARN("Invalid asset path, `%s`.\n", path);
+    return false;
+  }
 
-  vstd_string_free(&tmp);
+  return true;
 }
 
 // =============================================
@@ -143,49 +415,55 @@ _vgfx_as_validate_asset_path(const char *path) {
 //
 // =============================================
 
-void *
-_vgfx_as_load_texture(VGFX_AS_AssetDesc *desc) {
+bool 
+_vgfx_as_load(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, VGFX_AS_AssetDesc *desc, 
+              _VGFX_AS_Decoded *decoded) {
 
   VGFX_ASSERT_NON_NULL(desc);
-  VGFX_ASSERT_NON_ZERO(desc->texture_wrap);
-  VGFX_ASSERT_NON_ZERO(desc->texture_filter);
-
-  // Validate asset paths
-  _vgfx_as_validate_asset_path(desc->texture_path);
 
-  // Create OpenGL texture
-  VGFX_AS_TextureHandle th;
-  glGenTextures(1, &th);
-  glBindTexture(GL_TEXTURE_2D, th);
+  switch (desc->type) {
+  case VGFX_ASSET_TYPE_TEXTURE:
+    return (desc->texture_array) ? _vgfx_as_load_texture_layer(as, handle, desc, decoded)
+                                 : _vgfx_as_load_texture(as, handle, desc, decoded);
+  case VGFX_ASSET_TYPE_FONT:
+    return _vgfx_as_load_font(as, handle, desc, decoded);
+  case VGFX_ASSET_TYPE_SHADER:
+    return _vgfx_as_load_shader(as, handle, desc, decoded);
+  default:
+    VGFX_ABORT("Load function for this type is missing.");
+    break;
+  }
 
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (i32)desc->texture_wrap);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (i32)desc->texture_wrap);
+  return false;
+}
 
-  u32 min_filter = (desc->texture_filter == GL_LINEAR)
-                       ? GL_LINEAR_MIPMAP_LINEAR
-                       : GL_NEAREST_MIPMAP_NEAREST;
+bool 
+_vgfx_as_load_texture(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, 
+                      VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded) {
 
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (i32)min_filter);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-                  (i32)desc->texture_filter);
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(desc);
+  VGFX_ASSERT_NON_NULL(decoded);
+  VGFX_ASSERT_NON_ZERO(desc->texture_wrap);
+  VGFX_ASSERT_NON_ZERO(desc->texture_filter);
 
-  // Load and validate texture data
-  i32 width, height, channel;
-  u8 *data = stbi_load(desc->texture_path, &width, &height, &channel, 0);
+  VGFX_PROFILE_BEGIN(_vgfx_as_load_texture);
 
-  VGFX_ASSERT(data, "Failed to load texture from, `%s`.", desc->texture_path);
+  const i32 width   = decoded->width;
+  const i32 height  = decoded->height;
+  const i32 channel = decoded->channel;
 
   // Validate format
   u32 format;
   switch (channel) {
   case 1:
-    format = GL_RED;
+    format = GL_R8;
     break;
   case 3:
-    format = GL_RGB;
+    format = GL_RGB8;
     break;
   case 4:
-    format = GL_RGBA;
+    format = GL_RGBA8;
     break;
   default:
     VGFX_ABORT("Encountered unknown format when creating texture, `%d`.",
@@ -193,295 +471,1975 @@ _vgfx_as_load_texture(VGFX_AS_AssetDesc *desc) {
     break;
   }
 
-  // Upload the texture to GPU
-  glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format,
-               GL_UNSIGNED_BYTE, data);
-  glGenerateMipmap(GL_TEXTURE_2D);
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  stbi_image_free(data);
+  // Create OpenGL texture
+  u32 min_filter = (desc->texture_filter == GL_LINEAR)
+                       ? GL_LINEAR_MIPMAP_LINEAR
+                       : GL_NEAREST_MIPMAP_NEAREST;
 
-  // Create texture handle
-  VGFX_AS_Texture *handle = (VGFX_AS_Texture *)malloc(sizeof(VGFX_AS_Texture));
-  *handle = (VGFX_AS_Texture){
+  VGFX_AS_TextureHandle th = vgfx_gl_texture_create(&(VGFX_GL_TextureDesc){
+    .target = GL_TEXTURE_2D,
+    .format = format,
+    .width = width,
+    .height = height,
+    .wrap = desc->texture_wrap,
+    .min_filter = min_filter,
+    .mag_filter = desc->texture_filter,
+    .mipmaps = true,
+  });
+
+  // Fill the texture's slot
+  VGFX_AS_Texture *texture = (VGFX_AS_Texture *)_vgfx_as_asset_value(as, handle);
+  *texture = (VGFX_AS_Texture){
       .handle = th,
       .size = {width, height},
       .channel = channel,
+      .target = GL_TEXTURE_2D,
+      .layer = 0,
+      .uv_scale = {1.0f, 1.0f},
+      .opaque = decoded->opaque,
   };
 
-  return handle;
-}
-
-void *
-_vgfx_as_load_font(VGFX_AS_AssetDesc *desc) {
+  // Upload the texture to GPU, async textures keep their pixels until the queue drains,
+  // archived pixels are already resident and upload straight from the mapping
+  texture->ready = !desc->texture_async || decoded->borrowed;
 
-  VGFX_ASSERT_NON_NULL(desc);
-  VGFX_ASSERT_NON_ZERO(desc->font_size);
-  VGFX_ASSERT_NON_ZERO(desc->font_filter);
+  if (!texture->ready) {
+    _vgfx_as_upload_push(
+      as, handle, th, decoded->pixels, format, width, height, channel);
 
-  // Validate asset paths
-  _vgfx_as_validate_asset_path(desc->font_path);
+    decoded->pixels = NULL;
+  } else {
+    const u32 base = _vgfx_gl_texture_base_format(format);
 
-  // Setup Freetype
-  FT_Library ft;
-  VGFX_ASSERT(!FT_Init_FreeType(&ft), "Freetype failed to initiazlize.");
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    vgfx_gl_texture_sub_image(GL_TEXTURE_2D, th, 0, 0, 0, width, height, base, decoded->pixels);
 
-  FT_Face face;
-  VGFX_ASSERT(!FT_New_Face(ft, desc->font_path, 0, &face),
-              "Failed to load font from, `%s`.", desc->font_path);
+    if (decoded->levels == _vgfx_gl_texture_levels(width, height) && decoded->levels > 1) {
+      const u8 *level = decoded->pixels + (usize)width * height * channel;
 
-  VGFX_ASSERT(!FT_Set_Pixel_Sizes(face, 0, desc->font_size),
-              "Failed to set font size to `%u` pixels.", desc->font_size);
+      for (i32 i = 1; i < decoded->levels; ++i) {
+        const i32 w = (width >> i) ? (width >> i) : 1;
+        const i32 h = (height >> i) ? (height >> i) : 1;
 
-  // Load flags
-  const i32 load_flags = FT_LOAD_RENDER | FT_LOAD_TARGET_(FT_RENDER_MODE_SDF);
+        vgfx_gl_texture_level_image(th, i, w, h, format, level);
+        level += (usize)w * h * channel;
+      }
+    } else {
+      vgfx_gl_texture_generate_mipmap(GL_TEXTURE_2D, th);
+    }
 
-  // Create font handle
-  VGFX_AS_Font *font = (VGFX_AS_Font *)calloc(1, sizeof(VGFX_AS_Font));
+    _vgfx_as_decoded_free(VGFX_ASSET_TYPE_TEXTURE, decoded);
+  }
 
-  font->range[0] = desc->font_range[0];
-  font->range[1] = desc->font_range[1];
+  VGFX_PROFILE_END(_vgfx_as_load_texture);
 
-  font->_average_glyph_height = 0;
+  return true;
+}
 
-  // Calculate font size
-  for (u32 i = font->range[0]; i < font->range[1]; ++i) {
-    if (FT_Load_Char(face, i, load_flags)) {
-      fprintf(stderr, "Failed to load glyph for the character, `%d`.\n", i);
-      abort();
-    }
+bool 
+_vgfx_as_load_texture_layer(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, 
+                            VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded) {
 
-    font->size[0] += face->glyph->bitmap.width;
-    if (font->size[1] < (i32)face->glyph->bitmap.rows) {
-      font->size[1] = face->glyph->bitmap.rows;
-    }
-  }
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(desc);
+  VGFX_ASSERT_NON_NULL(decoded);
+  VGFX_ASSERT_NON_ZERO(desc->texture_wrap);
+  VGFX_ASSERT_NON_ZERO(desc->texture_filter);
 
-  // Create font's glyph vector
-  i32 cap = font->range[1] - font->range[0];
-  VGFX_ASSERT(cap > 0, "Invalid font range, upper bound has to be bigger.");
+  // Freeing a borrowed payload clears all of it, keep what the slot needs
+  const i32  width  = decoded->width;
+  const i32  height = decoded->height;
+  const bool opaque = decoded->opaque;
 
-  font->glyphs = vstd_vector_with_capacity(_VGFX_AS_Glyph, cap);
+  // Bucket by the next power of two of the larger edge
+  u32 size = VGFX_AS_TEXTURE_ARRAY_MIN_SIZE;
+  while (size < (u32)width || size < (u32)height) {
+    size <<= 1;
+  }
 
-  // Create texture handle
-  glGenTextures(1, &font->handle);
-  glBindTexture(GL_TEXTURE_2D, font->handle);
+  // Pages that would hold a single layer don't batch anything
+  const u32 capacity = _vgfx_as_texture_array_capacity(size);
+  if (capacity < 2) {
+    VGFX_DEBUG_WARN("Texture is too large for an array page, loading it as 2D.\n");
 
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return _vgfx_as_load_texture(as, handle, desc, decoded);
+  }
 
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc->font_filter);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, desc->font_filter);
+  // Repeating only works when the texture fills its whole layer
+  const bool repeat = desc->texture_wrap == GL_REPEAT || 
+                      desc->texture_wrap == GL_MIRRORED_REPEAT;
 
-  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, font->size[0], font->size[1], 0,
-               GL_RED, GL_UNSIGNED_BYTE, NULL);
-  glBindTexture(GL_TEXTURE_2D, 0);
+  if (repeat && ((u32)width != size || (u32)height != size)) {
+    VGFX_DEBUG_WARN("Repeating texture doesn't fill an array layer, loading it as 2D.\n");
 
-  // Bind the texture
-  glBindTexture(GL_TEXTURE_2D, font->handle);
-  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    return _vgfx_as_load_texture(as, handle, desc, decoded);
+  }
 
-  // Load glyphs
-  f32 a_height = 0.0f;
-  i32 x_offset = 0;
-  for (i32 i = 0; i < cap; ++i) {
-    _VGFX_AS_Glyph *glyph = &vstd_vector_get(_VGFX_AS_Glyph, font->glyphs, i);
+  VGFX_PROFILE_BEGIN(_vgfx_as_load_texture_layer);
 
-    if (FT_Load_Char(face, i + font->range[0], load_flags)) {
-      fprintf(stderr, "Failed to load glyph for the character, `%d`.\n", i);
-      abort();
-    }
+  // Find an array with a free layer and matching sampler state
+  VGFX_AS_TextureArray *array = NULL;
 
-    if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL)) {
-      fprintf(stderr, "Failed to render glyph for the character, `%d`.\n", i);
-      abort();
+  vstd_vector_iter(VGFX_AS_TextureArray, as->texture_arrays, {
+    if (!array && 
+        _$iter->size == size && 
+        _$iter->wrap == desc->texture_wrap && 
+        _$iter->filter == desc->texture_filter && 
+        _$iter->layers < _$iter->capacity) {
+      array = _$iter;
     }
+  });
+
+  if (!array) {
+    VGFX_AS_TextureArray tmp = {
+      .size = size,
+      .wrap = desc->texture_wrap,
+      .filter = desc->texture_filter,
+      .capacity = capacity,
+      .layers = 0,
+    };
+
+    u32 min_filter = (tmp.filter == GL_LINEAR)
+                         ? GL_LINEAR_MIPMAP_LINEAR
+                         : GL_NEAREST_MIPMAP_NEAREST;
+
+    tmp.handle = vgfx_gl_texture_create(&(VGFX_GL_TextureDesc){
+      .target = GL_TEXTURE_2D_ARRAY,
+      .format = GL_RGBA8,
+      .width = size,
+      .height = size,
+      .layers = capacity,
+      .wrap = tmp.wrap,
+      .min_filter = min_filter,
+      .mag_filter = tmp.filter,
+      .mipmaps = true,
+    });
 
-    glyph->advn[0] = face->glyph->advance.x >> 6;
-    glyph->advn[1] = face->glyph->advance.y >> 6;
-    glyph->size[0] = face->glyph->bitmap.width;
-    glyph->size[1] = face->glyph->bitmap.rows;
-    glyph->brng[0] = face->glyph->bitmap_left;
-    glyph->brng[1] = face->glyph->bitmap_top;
-    glyph->offset = (f32)x_offset / (f32)font->size[0];
-
-    glTexSubImage2D(GL_TEXTURE_2D, 0, x_offset, 0, glyph->size[0],
-                    glyph->size[1], GL_RED, GL_UNSIGNED_BYTE,
-                    face->glyph->bitmap.buffer);
+    vstd_vector_push(VGFX_AS_TextureArray, (&as->texture_arrays), tmp);
 
-    a_height += glyph->brng[1];
-    x_offset += glyph->size[0];
+    array = &vstd_vector_get(
+      VGFX_AS_TextureArray, as->texture_arrays, as->texture_arrays.len - 1);
   }
 
-  font->_average_glyph_height = a_height / cap;
+  // Upload the texture to the lowest free layer, released layers are reused
+  u32 layer = 0;
+  while (array->used & (1ull << layer)) {
+    layer += 1;
+  }
 
-  // Unbind texture
-  glBindTexture(GL_TEXTURE_2D, 0);
+  array->used   |= 1ull << layer;
+  array->layers += 1;
+  array->dirty   = true;
 
-  // Cleanup
-  FT_Done_Face(face);
-  FT_Done_FreeType(ft);
+  // Unused texels repeat the edges, so filtering and mipmaps don't pull in stale data
+  const u8 *pixels = decoded->pixels;
+  u8       *padded = NULL;
 
-  return font;
-}
+  if ((u32)width != size || (u32)height != size) {
+    padded = (u8 *)malloc((usize)size * size * 4);
+    VGFX_ASSERT(padded, "Failed to allocate padded layer.");
 
-void *
-_vgfx_as_load_shader(VGFX_AS_AssetDesc *desc) {
-  
-  VGFX_ASSERT_NON_NULL(desc);
+    for (u32 y = 0; y < size; ++y) {
+      const u32 row = (y < (u32)height) ? y : (u32)height - 1;
+      const u8 *src = decoded->pixels + (usize)row * width * 4;
+      u8       *dst = padded + (usize)y * size * 4;
 
-  // Validate asset paths
-  _vgfx_as_validate_asset_path(desc->shader_vert_path);
-  _vgfx_as_validate_asset_path(desc->shader_frag_path);
+      memcpy(dst, src, (usize)width * 4);
 
-  // Compile shaders
-  VSTD_String vert_source = vstd_fs_read_file(desc->shader_vert_path);
-  VGFX_AS_ShaderHandle vs = _vgfx_as_compile_shader(
-      GL_VERTEX_SHADER, (const char**)&vert_source.ptr);
-  vstd_string_free(&vert_source);
-  
-  VSTD_String frag_source = vstd_fs_read_file(desc->shader_frag_path);
-  VGFX_AS_ShaderHandle fs = _vgfx_as_compile_shader(
-      GL_FRAGMENT_SHADER, (const char**)&frag_source.ptr);
-  vstd_string_free(&frag_source);
+      for (u32 x = width; x < size; ++x) {
+        memcpy(&dst[x * 4], &src[(width - 1) * 4], 4);
+      }
+    }
 
-  if (!(vs && fs)) {
-    VGFX_ABORT("Shader failed to compile.");
+    pixels = padded;
   }
 
-  // Link shaders
-  VGFX_AS_ShaderHandle vec[2] = {vs, fs};
-  VGFX_AS_ShaderProgramHandle sp = _vgfx_as_compile_shader_program(vec, 2);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  vgfx_gl_texture_sub_image(GL_TEXTURE_2D_ARRAY, array->handle, 0, 0, layer, size, size, 
+                            GL_RGBA, pixels);
 
-  
-  if (!(vs && fs)) {
-    VGFX_ABORT("Shader Program failed to link.");
-  }
+  free(padded);
+
+  _vgfx_as_decoded_free(VGFX_ASSET_TYPE_TEXTURE, decoded);
 
-  VGFX_AS_Shader *handle = (VGFX_AS_Shader*)malloc(sizeof(VGFX_AS_Shader));
+  // Fill the texture's slot
+  VGFX_AS_Texture *texture = (VGFX_AS_Texture *)_vgfx_as_asset_value(as, handle);
+  *texture = (VGFX_AS_Texture){
+      .handle = array->handle,
+      .size = {width, height},
+      .channel = 4,
+      .target = GL_TEXTURE_2D_ARRAY,
+      .layer = layer,
+      .uv_scale = {(f32)width / (f32)size, (f32)height / (f32)size},
+      .opaque = opaque,
+      .ready = true,
+  };
 
-  handle->handle = sp;
+  VGFX_PROFILE_END(_vgfx_as_load_texture_layer);
 
-  return handle;
+  return true;
 }
 
-void 
-_vgfx_as_free_texture(VGFX_AS_Texture *handle) {
+u32 
+_vgfx_as_texture_array_capacity(u32 size) {
 
-  VGFX_ASSERT_NON_NULL(handle);
+  const VGFX_GL_Caps *caps = vgfx_gl_caps();
+
+  if (size > caps->max_texture_size) {
+    return 0;
+  }
 
-  glDeleteTextures(1, &handle->handle);
+  // Level 0 of a page stays within its byte budget, mipmaps add a third on top
+  usize capacity = VGFX_AS_TEXTURE_ARRAY_PAGE / ((usize)size * size * 4);
+
+  if (capacity > VGFX_AS_TEXTURE_ARRAY_LAYERS) {
+    capacity = VGFX_AS_TEXTURE_ARRAY_LAYERS;
+  }
+
+  if (capacity > caps->max_array_layers) {
+    capacity = caps->max_array_layers;
+  }
 
-  free(handle);
+  return (u32)capacity;
 }
 
 void 
-_vgfx_as_free_font(VGFX_AS_Font *handle) {
+_vgfx_as_texture_arrays_commit(VGFX_AS_AssetServer *as) {
 
-  VGFX_ASSERT_NON_NULL(handle);
+  VGFX_ASSERT_NON_NULL(as);
+
+  // Mipmaps are rebuilt once per page for every batch of loads, not per layer
+  vstd_vector_iter(VGFX_AS_TextureArray, as->texture_arrays, {
+    if (_$iter->dirty) {
+      vgfx_gl_texture_generate_mipmap(GL_TEXTURE_2D_ARRAY, _$iter->handle);
+      _$iter->dirty = false;
+    }
+  });
+}
 
-  glDeleteTextures(1, &handle->handle);
+bool 
+_vgfx_as_load_font(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, 
+                   VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded) {
 
-  vstd_vector_free(_VGFX_AS_Glyph, (&handle->glyphs));
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(desc);
+  VGFX_ASSERT_NON_NULL(decoded);
+  VGFX_ASSERT_NON_ZERO(desc->font_filter);
+
+  VGFX_PROFILE_BEGIN(_vgfx_as_load_font);
+
+  // Fill the font's slot
+  VGFX_AS_Font *font = (VGFX_AS_Font *)_vgfx_as_asset_value(as, handle);
+  *font = (VGFX_AS_Font){0};
+
+  font->range[0] = desc->font_range[0];
+  font->range[1] = desc->font_range[1];
+  font->size[0]  = decoded->atlas_width;
+  font->size[1]  = decoded->atlas_height;
+
+  font->_average_glyph_height = decoded->average_glyph_height;
 
-  free(handle);
+  // Create font's glyph vector
+  i32 cap = font->range[1] - font->range[0];
+
+  font->glyphs = vstd_vector_with_capacity(_VGFX_AS_Glyph, cap);
+
+  for (i32 i = 0; i < cap; ++i) {
+    vstd_vector_get(_VGFX_AS_Glyph, font->glyphs, i) = decoded->glyphs[i];
+  }
+
+  // Create texture handle and upload the whole atlas at once
+  font->handle = vgfx_gl_texture_create(&(VGFX_GL_TextureDesc){
+    .target = GL_TEXTURE_2D,
+    .format = GL_R8,
+    .width = font->size[0],
+    .height = font->size[1],
+    .wrap = GL_CLAMP_TO_EDGE,
+    .min_filter = desc->font_filter,
+    .mag_filter = desc->font_filter,
+  });
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  vgfx_gl_texture_sub_image(GL_TEXTURE_2D, font->handle, 0, 0, 0, decoded->atlas_width, 
+                            decoded->atlas_height, GL_RED, decoded->atlas);
+
+  _vgfx_as_decoded_free(VGFX_ASSET_TYPE_FONT, decoded);
+
+  VGFX_PROFILE_END(_vgfx_as_load_font);
+
+  return true;
 }
 
-void 
-_vgfx_as_free_shader(VGFX_AS_Shader *handle) {
+bool 
+_vgfx_as_load_shader(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, 
+                     VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded) {
   
-  VGFX_ASSERT_NON_NULL(handle);
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(desc);
+  VGFX_ASSERT_NON_NULL(decoded);
+
+  VGFX_PROFILE_BEGIN(_vgfx_as_load_shader);
+
+  // Compile shaders
+  VGFX_AS_ShaderHandle vs = _vgfx_as_compile_shader(GL_VERTEX_SHADER, &decoded->vert_source);
+  VGFX_AS_ShaderHandle fs = _vgfx_as_compile_shader(GL_FRAGMENT_SHADER, &decoded->frag_source);
+
+  _vgfx_as_decoded_free(VGFX_ASSET_TYPE_SHADER, decoded);
+
+  if (!(vs && fs)) {
+    VGFX_DEBUG_WARN("Shader failed to compile.\n");
+
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    return false;
+  }
+
+  // Link shaders
+  VGFX_AS_ShaderHandle vec[2] = {vs, fs};
+  VGFX_AS_ShaderProgramHandle sp = _vgfx_as_compile_shader_program(vec, 2);
 
-  glDeleteProgram(handle->handle);
+  if (!sp) {
+    VGFX_DEBUG_WARN("Shader Program failed to link.\n");
+    return false;
+  }
+
+  // Fill the shader's slot
+  VGFX_AS_Shader *shader = (VGFX_AS_Shader *)_vgfx_as_asset_value(as, handle);
+
+  shader->handle = sp;
+
+  _vgfx_as_shader_reflect(shader);
 
-  free(handle);
+  VGFX_PROFILE_END(_vgfx_as_load_shader);
+
+  return true;
 }
 
-u32 
-_vgfx_as_compile_shader(u32 type, const char** source) {
+bool 
+_vgfx_as_decode(VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded) {
 
-  VGFX_ASSERT_NON_NULL(source);
+  VGFX_ASSERT_NON_NULL(desc);
+  VGFX_ASSERT_NON_NULL(decoded);
 
-  VGFX_AS_ShaderHandle handle = glCreateShader(type);
+  *decoded = (_VGFX_AS_Decoded){0};
 
-  glShaderSource(handle, 1, source, NULL);
-  glCompileShader(handle);
+  switch (desc->type) {
+  case VGFX_ASSET_TYPE_TEXTURE:
+    return _vgfx_as_decode_texture(desc, decoded);
+  case VGFX_ASSET_TYPE_FONT:
+    return _vgfx_as_decode_font(desc, decoded);
+  case VGFX_ASSET_TYPE_SHADER:
+    return _vgfx_as_decode_shader(desc, decoded);
+  default:
+    VGFX_ABORT("Decode function for this type is missing.");
+    break;
+  }
 
-  int success;
-  char info_log[512];
-  glGetShaderiv(handle, GL_COMPILE_STATUS, &success);
+  return false;
+}
+
+bool 
+_vgfx_as_decode_texture(VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded) {
+
+  VGFX_PROFILE_BEGIN(_vgfx_as_decode_texture);
+
+  // Validate asset paths
+  if (!_vgfx_as_validate_asset_path(desc->texture_path)) {
+    return false;
+  }
+
+  VGFX_FS_File file;
+  if (!vgfx_fs_map(desc->texture_path, &file)) {
+    VGFX_DEBUG_WARN("Failed to read texture from, `%s`.\n", desc->texture_path);
+    return false;
+  }
+
+  // Load texture data, layers are always stored as RGBA
+  const i32 request = (desc->texture_array) ? 4 : 0;
+
+  i32 channel;
+  decoded->pixels = stbi_load_from_memory(
+    file.data, (i32)file.size, &decoded->width, &decoded->height, &channel, request);
+
+  vgfx_fs_unmap(&file);
+
+  if (!decoded->pixels) {
+    VGFX_DEBUG_WARN("Failed to load texture from, `%s`.\n", desc->texture_path);
+    return false;
+  }
 
+  decoded->channel = (request) ? request : channel;
+
+  if (decoded->channel == 2) {
+    VGFX_DEBUG_WARN("Encountered unknown format when creating texture, `%s`.\n", 
+                    desc->texture_path);
+
+    _vgfx_as_decoded_free(VGFX_ASSET_TYPE_TEXTURE, decoded);
+    return false;
+  }
+
+  decoded->opaque = _vgfx_as_texture_opaque(
+    decoded->pixels, decoded->width, decoded->height, decoded->channel);
+
+  VGFX_PROFILE_END(_vgfx_as_decode_texture);
+
+  return true;
+}
+
+bool 
+_vgfx_as_decode_font(VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded) {
+
+  VGFX_ASSERT_NON_ZERO(desc->font_size);
+
+  VGFX_PROFILE_BEGIN(_vgfx_as_decode_font);
+
+  // Validate asset paths
+  if (!_vgfx_as_validate_asset_path(desc->font_path)) {
+    return false;
+  }
+
+  const i32 cap = (i32)desc->font_range[1] - (i32)desc->font_range[0];
+  if (cap <= 0) {
+    VGFX_DEBUG_WARN("Invalid font range, upper bound has to be bigger.\n");
+    return false;
+  }
+
+  // Setup Freetype, every decode owns its library so workers never share one
+  FT_Library ft;
+  if (FT_Init_FreeType(&ft)) {
+    VGFX_DEBUG_WARN("Freetype failed to initiazlize.\n");
+    return false;
+  }
+
+  // The face reads straight from the mapping, it must outlive the face
+  VGFX_FS_File file;
+  if (!vgfx_fs_map(desc->font_path, &file)) {
+    VGFX_DEBUG_WARN("Failed to read font from, `%s`.\n", desc->font_path);
+
+    FT_Done_FreeType(ft);
+    return false;
+  }
+
+  FT_Face face;
+  if (FT_New_Memory_Face(ft, file.data, (FT_Long)file.size, 0, &face)) {
+    VGFX_DEBUG_WARN("Failed to load font from, `%s`.\n", desc->font_path);
+
+    vgfx_fs_unmap(&file);
+    FT_Done_FreeType(ft);
+    return false;
+  }
+
+  bool success = !FT_Set_Pixel_Sizes(face, 0, desc->font_size);
   if (!success) {
-    VSTD_String tmp;
+    VGFX_DEBUG_WARN("Failed to set font size to `%u` pixels.\n", desc->font_size);
+  }
 
-    switch (type) {
-    case GL_VERTEX_SHADER:
-      tmp = vstd_string_from(VSTD_STRINGIFY(GL_VERTEX_SHADER));
-      break;
-    // case GL_TESS_CONTROL_SHADER:
-    //   tmp = vstd_string_from(VSTD_STRINGIFY(GL_TESS_CONTROL_SHADER));
-    //   break;
-    // case GL_TESS_EVALUATION_SHADER:
-    //   tmp = vstd_string_from(VSTD_STRINGIFY(GL_TESS_EVALUATION_SHADER));
-    //   break;
-    case GL_GEOMETRY_SHADER:
-      tmp = vstd_string_from(VSTD_STRINGIFY(GL_GEOMETRY_SHADER));
+  // Load flags
+  const i32 load_flags = FT_LOAD_RENDER | FT_LOAD_TARGET_(FT_RENDER_MODE_SDF);
+
+  // Calculate atlas size
+  for (i32 i = 0; success && i < cap; ++i) {
+    if (FT_Load_Char(face, i + desc->font_range[0], load_flags)) {
+      VGFX_DEBUG_WARN("Failed to load glyph for the character, `%d`.\n", i);
+      success = false;
       break;
-    case GL_FRAGMENT_SHADER:
-      tmp = vstd_string_from(VSTD_STRINGIFY(GL_FRAGMENT_SHADER));
+    }
+
+    decoded->atlas_width += face->glyph->bitmap.width;
+    if (decoded->atlas_height < (i32)face->glyph->bitmap.rows) {
+      decoded->atlas_height = face->glyph->bitmap.rows;
+    }
+  }
+
+  if (success) {
+    decoded->atlas  = (u8 *)calloc((usize)decoded->atlas_width * decoded->atlas_height, 1);
+    decoded->glyphs = (_VGFX_AS_Glyph *)calloc(cap, sizeof(_VGFX_AS_Glyph));
+
+    VGFX_ASSERT(decoded->atlas && decoded->glyphs, "Failed to allocate font atlas.");
+  }
+
+  // Rasterize glyphs into the atlas
+  f32 a_height = 0.0f;
+  i32 x_offset = 0;
+  for (i32 i = 0; success && i < cap; ++i) {
+    _VGFX_AS_Glyph *glyph = &decoded->glyphs[i];
+
+    if (FT_Load_Char(face, i + desc->font_range[0], load_flags)) {
+      VGFX_DEBUG_WARN("Failed to load glyph for the character, `%d`.\n", i);
+      success = false;
       break;
-    // case GL_COMPUTE_SHADER:
-    //   tmp = vstd_string_from(VSTD_STRINGIFY(GL_COMPUTE_SHADER));
-    //   break;
-    default:
-      VGFX_ABORT("Failed to compile shader, unknown shader type `%d`.", type);
+    }
+
+    if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL)) {
+      VGFX_DEBUG_WARN("Failed to render glyph for the character, `%d`.\n", i);
+      success = false;
       break;
     }
 
-    glGetShaderInfoLog(handle, 512, NULL, info_log);
+    const FT_Bitmap *bitmap = &face->glyph->bitmap;
 
-    // TODO: Switch to VGFX_DEBUG_ERROR
-    VGFX_DEBUG_WARN("Failed to compile `%s`:\n%s", tmp.ptr, info_log);
+    glyph->advn[0] = face->glyph->advance.x >> 6;
+    glyph->advn[1] = face->glyph->advance.y >> 6;
+    glyph->size[0] = bitmap->width;
+    glyph->size[1] = bitmap->rows;
+    glyph->brng[0] = face->glyph->bitmap_left;
+    glyph->brng[1] = face->glyph->bitmap_top;
+    glyph->offset = (f32)x_offset / (f32)decoded->atlas_width;
 
-    vstd_string_free(&tmp);
-    glDeleteShader(handle);
+    for (u32 row = 0; row < bitmap->rows; ++row) {
+      memcpy(decoded->atlas + (usize)row * decoded->atlas_width + x_offset, 
+             bitmap->buffer + (i64)row * bitmap->pitch, bitmap->width);
+    }
 
-    return VGFX_GL_INVALID_HANDLE;
+    a_height += glyph->brng[1];
+    x_offset += glyph->size[0];
   }
 
-  return handle;
+  decoded->average_glyph_height = a_height / cap;
+
+  // Cleanup
+  FT_Done_Face(face);
+  FT_Done_FreeType(ft);
+  vgfx_fs_unmap(&file);
+
+  if (!success) {
+    _vgfx_as_decoded_free(VGFX_ASSET_TYPE_FONT, decoded);
+  }
+
+  VGFX_PROFILE_END(_vgfx_as_decode_font);
+
+  return success;
 }
 
-u32 
-_vgfx_as_compile_shader_program(VGFX_AS_ShaderHandle *vec, usize len) {
-  
-  VGFX_AS_ShaderProgramHandle handle = glCreateProgram();
+bool 
+_vgfx_as_decode_shader(VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded) {
 
-  for (usize i = 0; i < len; ++i) {
-    glAttachShader(handle, vec[i]);
+  VGFX_PROFILE_BEGIN(_vgfx_as_decode_shader);
+
+  // Sources stay mapped until compiled, glShaderSource takes explicit lengths
+  const bool vert = vgfx_fs_map(desc->shader_vert_path, &decoded->vert_source);
+  const bool frag = vgfx_fs_map(desc->shader_frag_path, &decoded->frag_source);
+
+  if (!(vert && frag)) {
+    VGFX_DEBUG_WARN("Invalid asset path, `%s`.\n", (vert) 
+                                                    ? desc->shader_frag_path 
+                                                    : desc->shader_vert_path);
+
+    _vgfx_as_decoded_free(VGFX_ASSET_TYPE_SHADER, decoded);
+    return false;
   }
 
-  glLinkProgram(handle);
+  VGFX_PROFILE_END(_vgfx_as_decode_shader);
 
-  for (usize i = 0; i < len; ++i) {
-    glDeleteShader(vec[i]);
+  return true;
+}
+
+void 
+_vgfx_as_decoded_free(VGFX_AS_AssetType type, _VGFX_AS_Decoded *decoded) {
+
+  VGFX_ASSERT_NON_NULL(decoded);
+
+  // Borrowed payloads belong to the archive's mapping
+  if (decoded->borrowed) {
+    *decoded = (_VGFX_AS_Decoded){0};
+    return;
   }
 
-  int success;
-  char info_log[512];
-  glGetProgramiv(handle, GL_LINK_STATUS, &success);
+  switch (type) {
+  case VGFX_ASSET_TYPE_TEXTURE:
+    if (decoded->pixels) {
+      stbi_image_free(decoded->pixels);
+      decoded->pixels = NULL;
+    }
+    break;
+  case VGFX_ASSET_TYPE_FONT:
+    free(decoded->atlas);
+    free(decoded->glyphs);
 
-  if (!success) {
-    glGetProgramInfoLog(handle, 512, NULL, info_log);
+    decoded->atlas  = NULL;
+    decoded->glyphs = NULL;
+    break;
+  case VGFX_ASSET_TYPE_SHADER:
+    vgfx_fs_unmap(&decoded->vert_source);
+    vgfx_fs_unmap(&decoded->frag_source);
+    break;
+  default:
+    break;
+  }
+}
 
-    // TODO: Switch to VGFX_DEBUG_ERROR
-    VGFX_DEBUG_WARN("Failed to link shader program:\n%s", info_log);
+bool 
+_vgfx_as_texture_opaque(const u8 *data, i32 width, i32 height, i32 channel) {
 
-    glDeleteProgram(handle);
+  // Formats without alpha sample as fully opaque
+  if (channel != 4) {
+    return true;
+  }
 
-    return VGFX_GL_INVALID_HANDLE;
+  const usize count = (usize)width * (usize)height;
+  for (usize i = 0; i < count; ++i) {
+    if (data[i * 4 + 3] != 0xFF) {
+      return false;
+    }
   }
 
-  return handle;
+  return true;
+}
+
+void 
+_vgfx_as_free_texture(VGFX_AS_AssetServer *as, VGFX_AS_Texture *handle) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(handle);
+
+  if (handle->target == GL_TEXTURE_2D) {
+    vgfx_gl_delete_texture(handle->handle);
+    return;
+  }
+
+  // Give the layer back, the array is deleted with its last layer
+  for (usize i = 0; i < as->texture_arrays.len; ++i) {
+    VGFX_AS_TextureArray *array = &vstd_vector_get(VGFX_AS_TextureArray, as->texture_arrays, i);
+
+    if (array->handle != handle->handle) {
+      continue;
+    }
+
+    VGFX_DEBUG_ASSERT(array->used & (1ull << handle->layer), "Layer isn't in use.");
+
+    array->used   &= ~(1ull << handle->layer);
+    array->layers -= 1;
+
+    // Order doesn't matter, the last array takes the empty one's place
+    if (!array->layers) {
+      _vgfx_as_free_texture_array(array);
+
+      *array = vstd_vector_get(
+        VGFX_AS_TextureArray, as->texture_arrays, as->texture_arrays.len - 1);
+      as->texture_arrays.len -= 1;
+    }
+
+    return;
+  }
+}
+
+void 
+_vgfx_as_free_texture_array(VGFX_AS_TextureArray *array) {
+
+  VGFX_ASSERT_NON_NULL(array);
+
+  vgfx_gl_delete_texture(array->handle);
+
+  array->handle = 0;
+  array->layers = 0;
+  array->used   = 0;
+}
+
+void 
+_vgfx_as_free_font(VGFX_AS_Font *handle) {
+
+  VGFX_ASSERT_NON_NULL(handle);
+
+  vgfx_gl_delete_texture(handle->handle);
+
+  vstd_vector_free(_VGFX_AS_Glyph, (&handle->glyphs));
+}
+
+void 
+_vgfx_as_free_shader(VGFX_AS_Shader *handle) {
+  
+  VGFX_ASSERT_NON_NULL(handle);
+
+  vgfx_gl_delete_shader_program(handle->handle);
+
+  free(handle->uniforms);
+}
+
+const VGFX_AS_Uniform *
+vgfx_as_shader_uniform(VGFX_AS_Shader *handle, const char *name) {
+
+  VGFX_ASSERT_NON_NULL(handle);
+  VGFX_ASSERT_NON_NULL(name);
+
+  if (!handle->uniform_count) {
+    return NULL;
+  }
+
+  const u32   hash = _vgfx_as_uniform_hash(name);
+  const usize mask = handle->uniform_cap - 1;
+
+  for (usize i = hash & mask;; i = (i + 1) & mask) {
+    VGFX_AS_Uniform *uniform = &handle->uniforms[i];
+
+    if (uniform->location < 0) {
+      return NULL;
+    }
+
+    if (uniform->hash == hash && !strcmp(uniform->name, name)) {
+      return uniform;
+    }
+  }
+}
+
+VGFX_AS_Texture *
+vgfx_as_texture(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle) {
+
+  return (VGFX_AS_Texture *)_vgfx_as_asset_resolve(as, handle, VGFX_ASSET_TYPE_TEXTURE);
+}
+
+VGFX_AS_Font *
+vgfx_as_font(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle) {
+
+  return (VGFX_AS_Font *)_vgfx_as_asset_resolve(as, handle, VGFX_ASSET_TYPE_FONT);
+}
+
+VGFX_AS_Shader *
+vgfx_as_shader(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle) {
+
+  return (VGFX_AS_Shader *)_vgfx_as_asset_resolve(as, handle, VGFX_ASSET_TYPE_SHADER);
+}
+
+void 
+_vgfx_as_shader_reflect(VGFX_AS_Shader *handle) {
+
+  VGFX_ASSERT_NON_NULL(handle);
+
+  i32 count;
+  glGetProgramiv(handle->handle, GL_ACTIVE_UNIFORMS, &count);
+
+  // Keep the table at most half full so probes stay short
+  usize cap = 8;
+  while (cap < (usize)count * 2) {
+    cap <<= 1;
+  }
+
+  handle->uniforms      = (VGFX_AS_Uniform *)malloc(cap * sizeof(VGFX_AS_Uniform));
+  handle->uniform_cap   = cap;
+  handle->uniform_count = 0;
+
+  VGFX_ASSERT(handle->uniforms, "Failed to allocate uniform table.");
+
+  for (usize i = 0; i < cap; ++i) {
+    handle->uniforms[i].location = -1;
+  }
+
+  vgfx_gl_bind_shader_program(handle->handle);
+
+  const i32 max_unit = (i32)vgfx_gl_caps()->max_texture_units - 1;
+
+  i32 unit = 0;
+  for (i32 i = 0; i < count; ++i) {
+    VGFX_AS_Uniform tmp;
+    glGetActiveUniform(
+      handle->handle, (u32)i, sizeof(tmp.name), NULL, &tmp.size, &tmp.type, tmp.name);
+
+    // Block members have no location
+    tmp.location = glGetUniformLocation(handle->handle, tmp.name);
+    if (tmp.location < 0) {
+      continue;
+    }
+
+    // Arrays are reported by their first element
+    char *bracket = strchr(tmp.name, '[');
+    if (bracket) {
+      *bracket = '\0';
+    }
+
+    tmp.hash = _vgfx_as_uniform_hash(tmp.name);
+
+    const usize mask = cap - 1;
+
+    usize slot = tmp.hash & mask;
+    while (handle->uniforms[slot].location >= 0) {
+      slot = (slot + 1) & mask;
+    }
+
+    handle->uniforms[slot] = tmp;
+    handle->uniform_count += 1;
+
+    // Samplers get consecutive units once, draws only bind textures
+    if (_vgfx_as_uniform_sampler(tmp.type)) {
+      i32 units[tmp.size];
+      for (i32 e = 0; e < tmp.size; ++e) {
+        units[e] = (unit < max_unit) ? unit++ : max_unit;
+      }
+
+      glUniform1iv(tmp.location, tmp.size, units);
+    }
+  }
+
+  vgfx_gl_unbind_shader_program();
+}
+
+u32 
+_vgfx_as_uniform_hash(const char *name) {
+
+  // FNV-1a
+  u32 hash = 2166136261u;
+  for (; *name; ++name) {
+    hash ^= (u8)*name;
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+bool 
+_vgfx_as_uniform_sampler(u32 type) {
+
+  switch (type) {
+  case GL_SAMPLER_1D:
+  case GL_SAMPLER_2D:
+  case GL_SAMPLER_3D:
+  case GL_SAMPLER_CUBE:
+  case GL_SAMPLER_1D_SHADOW:
+  case GL_SAMPLER_2D_SHADOW:
+  case GL_SAMPLER_1D_ARRAY:
+  case GL_SAMPLER_2D_ARRAY:
+  case GL_SAMPLER_2D_ARRAY_SHADOW:
+  case GL_SAMPLER_CUBE_SHADOW:
+  case GL_SAMPLER_2D_RECT:
+  case GL_SAMPLER_BUFFER:
+  case GL_SAMPLER_2D_MULTISAMPLE:
+  case GL_INT_SAMPLER_2D:
+  case GL_INT_SAMPLER_2D_ARRAY:
+  case GL_UNSIGNED_INT_SAMPLER_2D:
+  case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+    return true;
+  default:
+    return false;
+  }
+}
+
+u32 
+_vgfx_as_compile_shader(u32 type, const VGFX_FS_File *source) {
+
+  VGFX_ASSERT_NON_NULL(source);
+
+  VGFX_AS_ShaderHandle handle = glCreateShader(type);
+
+  const char *data = (source->data) ? (const char *)source->data : "";
+  const i32 length = (i32)source->size;
+
+  glShaderSource(handle, 1, &data, &length);
+  glCompileShader(handle);
+
+  int success;
+  char info_log[512];
+  glGetShaderiv(handle, GL_COMPILE_STATUS, &success);
+
+  if (!success) {
+    VSTD_String tmp;
+
+    switch (type) {
+    case GL_VERTEX_SHADER:
+      tmp = vstd_string_from(VSTD_STRINGIFY(GL_VERTEX_SHADER));
+      break;
+    // case GL_TESS_CONTROL_SHADER:
+    //   tmp = vstd_string_from(VSTD_STRINGIFY(GL_TESS_CONTROL_SHADER));
+    //   break;
+    // case GL_TESS_EVALUATION_SHADER:
+    //   tmp = vstd_string_from(VSTD_STRINGIFY(GL_TESS_EVALUATION_SHADER));
+    //   break;
+    case GL_GEOMETRY_SHADER:
+      tmp = vstd_string_from(VSTD_STRINGIFY(GL_GEOMETRY_SHADER));
+      break;
+    case GL_FRAGMENT_SHADER:
+      tmp = vstd_string_from(VSTD_STRINGIFY(GL_FRAGMENT_SHADER));
+      break;
+    // case GL_COMPUTE_SHADER:
+    //   tmp = vstd_string_from(VSTD_STRINGIFY(GL_COMPUTE_SHADER));
+    //   break;
+    default:
+      VGFX_ABORT("Failed to compile shader, unknown shader type `%d`.", type);
+      break;
+    }
+
+    glGetShaderInfoLog(handle, 512, NULL, info_log);
+
+    // TODO: Switch to VGFX_DEBUG_ERROR
+    VGFX_DEBUG_WARN("Failed to compile `%s`:\n%s", tmp.ptr, info_log);
+
+    vstd_string_free(&tmp);
+    glDeleteShader(handle);
+
+    return VGFX_GL_INVALID_HANDLE;
+  }
+
+  return handle;
+}
+
+u32 
+_vgfx_as_compile_shader_program(VGFX_AS_ShaderHandle *vec, usize len) {
+  
+  VGFX_AS_ShaderProgramHandle handle = glCreateProgram();
+
+  for (usize i = 0; i < len; ++i) {
+    glAttachShader(handle, vec[i]);
+  }
+
+  glLinkProgram(handle);
+
+  for (usize i = 0; i < len; ++i) {
+    glDeleteShader(vec[i]);
+  }
+
+  int success;
+  char info_log[512];
+  glGetProgramiv(handle, GL_LINK_STATUS, &success);
+
+  if (!success) {
+    glGetProgramInfoLog(handle, 512, NULL, info_log);
+
+    // TODO: Switch to VGFX_DEBUG_ERROR
+    VGFX_DEBUG_WARN("Failed to link shader program:\n%s", info_log);
+
+    glDeleteProgram(handle);
+
+    return VGFX_GL_INVALID_HANDLE;
+  }
+
+  return handle;
+}
+
+// =============================================
+//
+//
+// Texture Uploads
+//
+//
+// =============================================
+
+void 
+_vgfx_as_upload_init(_VGFX_AS_UploadQueue *queue) {
+
+  VGFX_ASSERT_NON_NULL(queue);
+
+  // GL objects are created with the first upload, the context may not exist yet
+  *queue = (_VGFX_AS_UploadQueue){
+    .pending = vstd_vector_new(_VGFX_AS_Upload),
+    .budget = VGFX_AS_UPLOAD_DEFAULT_BUDGET,
+  };
+}
+
+void 
+_vgfx_as_upload_free(VGFX_AS_AssetServer *as) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  _VGFX_AS_UploadQueue *queue = &as->upload;
+
+  for (usize i = queue->head; i < queue->pending.len; ++i) {
+    _VGFX_AS_Upload *upload = &vstd_vector_get(_VGFX_AS_Upload, queue->pending, i);
+
+    if (upload->asset) {
+      VGFX_AS_Texture *texture = (VGFX_AS_Texture *)_vgfx_as_asset_value(as, upload->asset);
+      texture->handle = upload->handle;
+
+      stbi_image_free(upload->data);
+    }
+  }
+
+  vstd_vector_free(_VGFX_AS_Upload, (&queue->pending));
+
+  for (usize i = 0; i < VGFX_AS_UPLOAD_RING_SIZE; ++i) {
+    if (queue->fences[i]) {
+      VGFX_GL_Fence fence = (VGFX_GL_Fence)queue->fences[i];
+      vgfx_gl_fence_delete(&fence);
+    }
+
+    if (queue->buffers[i]) {
+      VGFX_GL_Buffer buff = {.handle = queue->buffers[i], .type = GL_PIXEL_UNPACK_BUFFER};
+      vgfx_gl_buffer_delete(&buff);
+    }
+  }
+
+  if (queue->placeholder) {
+    vgfx_gl_delete_texture(queue->placeholder);
+  }
+}
+
+void 
+_vgfx_as_upload_push(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle asset, u32 handle, 
+                     u8 *data, u32 format, i32 width, i32 height, i32 channel) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT(_vgfx_as_asset_get(as, asset), "Upload for a stale asset, `%08x`.", asset);
+  VGFX_ASSERT((usize)width * channel <= VGFX_AS_UPLOAD_SEGMENT_SIZE, 
+              "Texture row doesn't fit an upload segment, `%d`.", width);
+
+  _VGFX_AS_UploadQueue *queue = &as->upload;
+
+  // Single white texel stands in for every texture still uploading
+  if (!queue->placeholder) {
+    queue->placeholder = vgfx_gl_texture_create(&(VGFX_GL_TextureDesc){
+      .target = GL_TEXTURE_2D,
+      .format = GL_RGBA8,
+      .width = 1,
+      .height = 1,
+      .wrap = GL_CLAMP_TO_EDGE,
+      .min_filter = GL_NEAREST,
+      .mag_filter = GL_NEAREST,
+    });
+
+    vgfx_gl_texture_sub_image(GL_TEXTURE_2D, queue->placeholder, 0, 0, 0, 1, 1, GL_RGBA, 
+                              (u8[4]){0xFF, 0xFF, 0xFF, 0xFF});
+
+    for (usize i = 0; i < VGFX_AS_UPLOAD_RING_SIZE; ++i) {
+      VGFX_GL_Buffer buff = vgfx_gl_buffer_create(GL_PIXEL_UNPACK_BUFFER);
+      vgfx_gl_buffer_data(&buff, GL_STREAM_DRAW, VGFX_AS_UPLOAD_SEGMENT_SIZE, NULL);
+
+      queue->buffers[i] = buff.handle;
+    }
+
+    vgfx_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, VGFX_GL_INVALID_HANDLE);
+  }
+
+  VGFX_AS_Texture *texture = (VGFX_AS_Texture *)_vgfx_as_asset_value(as, asset);
+  texture->handle = queue->placeholder;
+
+  _VGFX_AS_Upload upload = {
+    .asset = asset,
+    .handle = handle,
+    .data = data,
+    .format = _vgfx_gl_texture_base_format(format),
+    .width = width,
+    .height = height,
+    .row = 0,
+    .pitch = (usize)width * channel,
+  };
+  vstd_vector_push(_VGFX_AS_Upload, (&queue->pending), upload);
+}
+
+void 
+_vgfx_as_upload_cancel(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle asset) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  _VGFX_AS_UploadQueue *queue = &as->upload;
+
+  for (usize i = queue->head; i < queue->pending.len; ++i) {
+    _VGFX_AS_Upload *upload = &vstd_vector_get(_VGFX_AS_Upload, queue->pending, i);
+
+    // Cancelled entries are skipped by the next step
+    if (upload->asset == asset) {
+      VGFX_AS_Texture *texture = (VGFX_AS_Texture *)_vgfx_as_asset_value(as, asset);
+      texture->handle = upload->handle;
+
+      stbi_image_free(upload->data);
+
+      upload->asset = VGFX_AS_INVALID_ASSET;
+      upload->data  = NULL;
+    }
+  }
+}
+
+bool 
+_vgfx_as_upload_step(VGFX_AS_AssetServer *as, usize *budget) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(budget);
+
+  _VGFX_AS_UploadQueue *queue = &as->upload;
+
+  while (queue->head < queue->pending.len && 
+         !vstd_vector_get(_VGFX_AS_Upload, queue->pending, queue->head).asset) {
+    queue->head += 1;
+  }
+
+  if (queue->head == queue->pending.len) {
+    vstd_vector_clear(_VGFX_AS_Upload, (&queue->pending));
+    queue->head = 0;
+
+    return false;
+  }
+
+  // Never wait on the GPU, a busy segment ends this frame's uploads
+  void **slot = &queue->fences[queue->segment];
+  if (*slot) {
+    VGFX_GL_Fence fence = (VGFX_GL_Fence)*slot;
+    if (!vgfx_gl_fence_signaled(&fence)) {
+      return false;
+    }
+
+    vgfx_gl_fence_delete(&fence);
+    *slot = NULL;
+  }
+
+  _VGFX_AS_Upload *upload = &vstd_vector_get(_VGFX_AS_Upload, queue->pending, queue->head);
+
+  // At least one row per step so small budgets still make progress
+  const usize limit = (*budget < VGFX_AS_UPLOAD_SEGMENT_SIZE) ? *budget 
+                                                              : VGFX_AS_UPLOAD_SEGMENT_SIZE;
+
+  i32 rows = (i32)(limit / upload->pitch);
+  if (rows < 1) {
+    rows = 1;
+  }
+  if (rows > upload->height - upload->row) {
+    rows = upload->height - upload->row;
+  }
+
+  const usize size = (usize)rows * upload->pitch;
+
+  VGFX_GL_Buffer buff = {
+    .handle = queue->buffers[queue->segment],
+    .type = GL_PIXEL_UNPACK_BUFFER,
+    .size = VGFX_AS_UPLOAD_SEGMENT_SIZE,
+  };
+
+  void *ptr = vgfx_gl_buffer_map_range(
+    &buff, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  memcpy(ptr, upload->data + (usize)upload->row * upload->pitch, size);
+  vgfx_gl_buffer_unmap(&buff);
+
+  // Rows are tightly packed in the staging buffer
+  vgfx_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, buff.handle);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  vgfx_gl_texture_sub_image(GL_TEXTURE_2D, upload->handle, 0, upload->row, 0, 
+                            upload->width, rows, upload->format, NULL);
+
+  vgfx_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, VGFX_GL_INVALID_HANDLE);
+
+  queue->fences[queue->segment] = vgfx_gl_fence_create();
+  queue->segment = (queue->segment + 1) % VGFX_AS_UPLOAD_RING_SIZE;
+
+  upload->row += rows;
+  *budget     -= (size < *budget) ? size : *budget;
+
+  if (upload->row == upload->height) {
+    _vgfx_as_upload_complete(as, upload);
+
+    queue->head += 1;
+    if (queue->head == queue->pending.len) {
+      vstd_vector_clear(_VGFX_AS_Upload, (&queue->pending));
+      queue->head = 0;
+    }
+  }
+
+  return true;
+}
+
+void 
+_vgfx_as_upload_complete(VGFX_AS_AssetServer *as, _VGFX_AS_Upload *upload) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(upload);
+
+  vgfx_gl_texture_generate_mipmap(GL_TEXTURE_2D, upload->handle);
+
+  stbi_image_free(upload->data);
+  upload->data = NULL;
+
+  VGFX_AS_Texture *texture = (VGFX_AS_Texture *)_vgfx_as_asset_value(as, upload->asset);
+
+  texture->handle = upload->handle;
+  texture->ready  = true;
+}
+
+// =============================================
+//
+//
+// Asset Workers
+//
+//
+// =============================================
+
+void 
+_vgfx_as_workers_init(_VGFX_AS_WorkerPool *pool) {
+
+  VGFX_ASSERT_NON_NULL(pool);
+
+  *pool = (_VGFX_AS_WorkerPool){0};
+
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->wake, NULL);
+  pthread_cond_init(&pool->finished, NULL);
+}
+
+void 
+_vgfx_as_workers_free(_VGFX_AS_WorkerPool *pool) {
+
+  VGFX_ASSERT_NON_NULL(pool);
+
+  pthread_mutex_lock(&pool->lock);
+  pool->quit = true;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (usize i = 0; i < pool->count; ++i) {
+    pthread_join(pool->threads[i], NULL);
+  }
+
+  // Workers are gone, whatever is left is only reachable from here
+  _VGFX_AS_Job *lists[2] = {pool->queued, pool->done};
+  for (usize i = 0; i < 2; ++i) {
+    for (_VGFX_AS_Job *job = lists[i]; job;) {
+      _VGFX_AS_Job *next = job->next;
+
+      if (i == 1 && !job->failed) {
+        _vgfx_as_decoded_free(job->desc.type, &job->decoded);
+      }
+
+      _vgfx_as_job_free(job);
+      job = next;
+    }
+  }
+
+  pthread_cond_destroy(&pool->finished);
+  pthread_cond_destroy(&pool->wake);
+  pthread_mutex_destroy(&pool->lock);
+
+  *pool = (_VGFX_AS_WorkerPool){0};
+}
+
+void 
+_vgfx_as_workers_submit(_VGFX_AS_WorkerPool *pool, _VGFX_AS_Job *job) {
+
+  VGFX_ASSERT_NON_NULL(pool);
+  VGFX_ASSERT_NON_NULL(job);
+
+  // Leave one core to the GL thread
+  if (!pool->count) {
+    i64 cores = sysconf(_SC_NPROCESSORS_ONLN) - 1;
+    if (cores < 1) {
+      cores = 1;
+    }
+
+    const usize count = (cores < VGFX_AS_MAX_WORKERS) ? (usize)cores : VGFX_AS_MAX_WORKERS;
+
+    for (usize i = 0; i < count; ++i) {
+      VGFX_ASSERT(!pthread_create(&pool->threads[i], NULL, _vgfx_as_worker_main, pool),
+                  "Failed to spawn asset worker `%zu`.", i);
+    }
+
+    pool->count = count;
+  }
+
+  pool->pending += 1;
+
+  pthread_mutex_lock(&pool->lock);
+
+  job->next = NULL;
+  if (pool->queued_tail) {
+    pool->queued_tail->next = job;
+  } else {
+    pool->queued = job;
+  }
+  pool->queued_tail = job;
+
+  pthread_cond_signal(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+_VGFX_AS_Job *
+_vgfx_as_workers_drain(_VGFX_AS_WorkerPool *pool, bool block) {
+
+  VGFX_ASSERT_NON_NULL(pool);
+
+  pthread_mutex_lock(&pool->lock);
+
+  while (block && !pool->done) {
+    pthread_cond_wait(&pool->finished, &pool->lock);
+  }
+
+  _VGFX_AS_Job *done = pool->done;
+  pool->done = NULL;
+
+  pthread_mutex_unlock(&pool->lock);
+
+  // Finished jobs are pushed in front, restore completion order
+  _VGFX_AS_Job *ordered = NULL;
+  while (done) {
+    _VGFX_AS_Job *next = done->next;
+    done->next = ordered;
+    ordered = done;
+    done = next;
+  }
+
+  return ordered;
+}
+
+void 
+_vgfx_as_workers_finish(VGFX_AS_AssetServer *as, _VGFX_AS_Job *jobs) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  while (jobs) {
+    _VGFX_AS_Job  *next  = jobs->next;
+    VGFX_AS_Asset *asset = _vgfx_as_asset_get(as, jobs->asset);
+
+    const bool loaded = !jobs->failed && 
+                        _vgfx_as_load(as, jobs->asset, &jobs->desc, &jobs->decoded);
+
+    asset->state = (loaded) ? VGFX_ASSET_STATE_READY : VGFX_ASSET_STATE_FAILED;
+
+    // Failures aren't shared, the next load of the same key retries
+    if (!loaded) {
+      _vgfx_as_cache_remove(as, jobs->asset);
+    }
+
+    // Released while it was loading
+    if (!asset->refs) {
+      _vgfx_as_asset_free(as, jobs->asset);
+    }
+
+    as->workers.pending -= 1;
+
+    _vgfx_as_job_free(jobs);
+    jobs = next;
+  }
+
+  _vgfx_as_texture_arrays_commit(as);
+}
+
+void *
+_vgfx_as_worker_main(void *arg) {
+
+  _VGFX_AS_WorkerPool *pool = (_VGFX_AS_WorkerPool *)arg;
+
+  for (;;) {
+    pthread_mutex_lock(&pool->lock);
+
+    while (!pool->quit && !pool->queued) {
+      pthread_cond_wait(&pool->wake, &pool->lock);
+    }
+
+    if (pool->quit) {
+      pthread_mutex_unlock(&pool->lock);
+      break;
+    }
+
+    _VGFX_AS_Job *job = pool->queued;
+
+    pool->queued = job->next;
+    if (!pool->queued) {
+      pool->queued_tail = NULL;
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    // CPU only, GL objects are created by the owning thread
+    job->failed = !_vgfx_as_decode(&job->desc, &job->decoded);
+
+    pthread_mutex_lock(&pool->lock);
+
+    job->next = pool->done;
+    pool->done = job;
+
+    pthread_cond_signal(&pool->finished);
+    pthread_mutex_unlock(&pool->lock);
+  }
+
+  return NULL;
+}
+
+_VGFX_AS_Job *
+_vgfx_as_job_new(VGFX_AS_AssetHandle asset, VGFX_AS_AssetDesc *desc) {
+
+  VGFX_ASSERT_NON_ZERO(asset);
+  VGFX_ASSERT_NON_NULL(desc);
+
+  _VGFX_AS_Job *job = (_VGFX_AS_Job *)calloc(1, sizeof(_VGFX_AS_Job));
+  VGFX_ASSERT(job, "Failed to allocate asset job.");
+
+  job->asset = asset;
+  job->desc  = *desc;
+
+  // The caller's paths may not outlive the decode
+  switch (desc->type) {
+  case VGFX_ASSET_TYPE_TEXTURE:
+    VGFX_ASSERT_NON_NULL(desc->texture_path);
+
+    job->paths[0] = strdup(desc->texture_path);
+    job->desc.texture_path = job->paths[0];
+    break;
+  case VGFX_ASSET_TYPE_FONT:
+    VGFX_ASSERT_NON_NULL(desc->font_path);
+
+    job->paths[0] = strdup(desc->font_path);
+    job->desc.font_path = job->paths[0];
+    break;
+  case VGFX_ASSET_TYPE_SHADER:
+    VGFX_ASSERT_NON_NULL(desc->shader_vert_path);
+    VGFX_ASSERT_NON_NULL(desc->shader_frag_path);
+
+    job->paths[0] = strdup(desc->shader_vert_path);
+    job->paths[1] = strdup(desc->shader_frag_path);
+    job->desc.shader_vert_path = job->paths[0];
+    job->desc.shader_frag_path = job->paths[1];
+    break;
+  default:
+    break;
+  }
+
+  return job;
+}
+
+void 
+_vgfx_as_job_free(_VGFX_AS_Job *job) {
+
+  VGFX_ASSERT_NON_NULL(job);
+
+  free(job->paths[0]);
+  free(job->paths[1]);
+  free(job);
+}
+
+// =============================================
+//
+//
+// Asset Cache
+//
+//
+// =============================================
+
+void 
+_vgfx_as_cache_init(_VGFX_AS_Cache *cache) {
+
+  VGFX_ASSERT_NON_NULL(cache);
+
+  cache->buckets = 
+    (VGFX_AS_AssetHandle *)calloc(VGFX_AS_CACHE_MIN_BUCKETS, sizeof(VGFX_AS_AssetHandle));
+  cache->cap     = VGFX_AS_CACHE_MIN_BUCKETS;
+  cache->count   = 0;
+
+  VGFX_ASSERT(cache->buckets, "Failed to allocate asset cache.");
+}
+
+void 
+_vgfx_as_cache_free(_VGFX_AS_Cache *cache) {
+
+  VGFX_ASSERT_NON_NULL(cache);
+
+  // Assets are owned by the server, only the buckets go
+  free(cache->buckets);
+
+  *cache = (_VGFX_AS_Cache){0};
+}
+
+VGFX_AS_AssetHandle 
+_vgfx_as_cache_find(VGFX_AS_AssetServer *as, const char *key, u64 hash) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(key);
+
+  _VGFX_AS_Cache *cache = &as->cache;
+
+  VGFX_AS_AssetHandle handle = cache->buckets[hash & (cache->cap - 1)];
+  while (handle) {
+    VGFX_AS_Asset *asset = _vgfx_as_asset_get(as, handle);
+
+    if (asset->_hash == hash && !strcmp(asset->_key.ptr, key)) {
+      return handle;
+    }
+
+    handle = asset->_next;
+  }
+
+  return VGFX_AS_INVALID_ASSET;
+}
+
+void 
+_vgfx_as_cache_insert(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  _VGFX_AS_Cache *cache = &as->cache;
+
+  // Keep chains around one entry long
+  if (cache->count + 1 > cache->cap) {
+    const usize cap = cache->cap * 2;
+
+    VGFX_AS_AssetHandle *buckets = 
+      (VGFX_AS_AssetHandle *)calloc(cap, sizeof(VGFX_AS_AssetHandle));
+    VGFX_ASSERT(buckets, "Failed to grow asset cache.");
+
+    for (usize i = 0; i < cache->cap; ++i) {
+      for (VGFX_AS_AssetHandle it = cache->buckets[i]; it;) {
+        VGFX_AS_Asset *asset = _vgfx_as_asset_get(as, it);
+
+        const VGFX_AS_AssetHandle next = asset->_next;
+
+        asset->_next = buckets[asset->_hash & (cap - 1)];
+        buckets[asset->_hash & (cap - 1)] = it;
+
+        it = next;
+      }
+    }
+
+    free(cache->buckets);
+
+    cache->buckets = buckets;
+    cache->cap     = cap;
+  }
+
+  VGFX_AS_Asset *asset = _vgfx_as_asset_get(as, handle);
+  VGFX_ASSERT(asset, "Cached a stale asset handle, `%08x`.", handle);
+
+  VGFX_AS_AssetHandle *bucket = &cache->buckets[asset->_hash & (cache->cap - 1)];
+
+  asset->_next = *bucket;
+  *bucket      = handle;
+
+  cache->count += 1;
+}
+
+void 
+_vgfx_as_cache_remove(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle) {
+
+  VGFX_ASSERT_NON_NULL(as);
+
+  _VGFX_AS_Cache *cache = &as->cache;
+
+  VGFX_AS_Asset *asset = _vgfx_as_asset_get(as, handle);
+  VGFX_ASSERT(asset, "Uncached a stale asset handle, `%08x`.", handle);
+
+  // Assets may already be gone, failed loads are dropped early
+  VGFX_AS_AssetHandle *link = &cache->buckets[asset->_hash & (cache->cap - 1)];
+  while (*link) {
+    if (*link == handle) {
+      *link        = asset->_next;
+      asset->_next = VGFX_AS_INVALID_ASSET;
+
+      cache->count -= 1;
+      return;
+    }
+
+    link = &_vgfx_as_asset_get(as, *link)->_next;
+  }
+}
+
+VSTD_String 
+_vgfx_as_cache_key(VGFX_AS_AssetDesc *desc) {
+
+  VGFX_ASSERT_NON_NULL(desc);
+
+  // Relative paths and symlinks resolve to the same file, missing files keep theirs
+  const char *paths[2] = {NULL, NULL};
+  char       *canon[2] = {NULL, NULL};
+
+  switch (desc->type) {
+  case VGFX_ASSET_TYPE_TEXTURE:
+    paths[0] = desc->texture_path;
+    break;
+  case VGFX_ASSET_TYPE_FONT:
+    paths[0] = desc->font_path;
+    break;
+  case VGFX_ASSET_TYPE_SHADER:
+    VGFX_ASSERT_NON_NULL(desc->shader_frag_path);
+
+    paths[0] = desc->shader_vert_path;
+    paths[1] = desc->shader_frag_path;
+    break;
+  default:
+    break;
+  }
+
+  VGFX_ASSERT_NON_NULL(paths[0]);
+
+  for (usize i = 0; i < 2; ++i) {
+    if (paths[i] && (canon[i] = realpath(paths[i], NULL))) {
+      paths[i] = canon[i];
+    }
+  }
+
+  VSTD_String key = {0};
+  switch (desc->type) {
+  case VGFX_ASSET_TYPE_TEXTURE:
+    key = vstd_string_format("texture|%s|%u|%u|%d", paths[0], desc->texture_wrap, 
+                             desc->texture_filter, (i32)desc->texture_array);
+    break;
+  case VGFX_ASSET_TYPE_FONT:
+    key = vstd_string_format("font|%s|%u|%u|%u|%u", paths[0], desc->font_size, 
+                             desc->font_filter, desc->font_range[0], desc->font_range[1]);
+    break;
+  case VGFX_ASSET_TYPE_SHADER:
+    key = vstd_string_format("shader|%s|%s", paths[0], paths[1]);
+    break;
+  default:
+    VGFX_ABORT("Cache key for this type is missing.");
+    break;
+  }
+
+  free(canon[0]);
+  free(canon[1]);
+
+  return key;
+}
+
+u64 
+_vgfx_as_cache_hash(const char *key) {
+
+  // FNV-1a
+  u64 hash = 14695981039346656037ull;
+  for (; *key; ++key) {
+    hash ^= (u8)*key;
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+// =============================================
+//
+//
+// Asset Slots
+//
+//
+// =============================================
+
+void 
+_vgfx_as_slots_init(_VGFX_AS_SlotMap *slots, usize stride) {
+
+  VGFX_ASSERT_NON_NULL(slots);
+  VGFX_ASSERT_NON_ZERO(stride);
+
+  *slots = (_VGFX_AS_SlotMap){
+    .stride = stride,
+    .free_head = UINT32_MAX,
+  };
+}
+
+void 
+_vgfx_as_slots_free(_VGFX_AS_SlotMap *slots) {
+
+  VGFX_ASSERT_NON_NULL(slots);
+
+  for (u32 i = 0; i < slots->cap / VGFX_AS_SLOT_PAGE_SIZE; ++i) {
+    free(slots->pages[i]);
+  }
+
+  *slots = (_VGFX_AS_SlotMap){0};
+}
+
+u32 
+_vgfx_as_slots_alloc(_VGFX_AS_SlotMap *slots) {
+
+  VGFX_ASSERT_NON_NULL(slots);
+
+  // Reuse the most recently freed slot, its generation already moved on
+  if (slots->free_head != UINT32_MAX) {
+    const u32 index = slots->free_head;
+
+    VGFX_AS_Asset *asset = _vgfx_as_slots_asset(slots, index);
+
+    slots->free_head  = asset->_free;
+    asset->alive      = true;
+    slots->count     += 1;
+
+    return index;
+  }
+
+  // Slots are handed out in order, so the next one is always at the end
+  const u32 index = slots->count;
+
+  VGFX_ASSERT(index < (1u << VGFX_AS_HANDLE_INDEX_BITS), 
+              "Asset slots are exhausted, `%u`.", index);
+
+  // Grow by a whole page, earlier pages stay where they are
+  if (index == slots->cap) {
+    _VGFX_AS_SlotPage *page = (_VGFX_AS_SlotPage *)calloc(
+      1, sizeof(_VGFX_AS_SlotPage) + VGFX_AS_SLOT_PAGE_SIZE * slots->stride);
+
+    VGFX_ASSERT(page, "Failed to grow asset slots.");
+
+    slots->pages[index >> VGFX_AS_SLOT_PAGE_BITS]  = page;
+    slots->cap                                    += VGFX_AS_SLOT_PAGE_SIZE;
+  }
+
+  _vgfx_as_slots_asset(slots, index)->alive  = true;
+  slots->count                              += 1;
+
+  return index;
+}
+
+void 
+_vgfx_as_slots_release(_VGFX_AS_SlotMap *slots, u32 index) {
+
+  VGFX_ASSERT_NON_NULL(slots);
+  VGFX_ASSERT(index < slots->cap && _vgfx_as_slots_asset(slots, index)->alive, 
+              "Released a dead asset slot, `%u`.", index);
+
+  VGFX_AS_Asset *asset = _vgfx_as_slots_asset(slots, index);
+
+  // Every handle still pointing here turns stale
+  *asset = (VGFX_AS_Asset){
+    .generation = asset->generation + 1,
+    ._free = slots->free_head,
+  };
+
+  memset(_vgfx_as_slots_value(slots, index), 0, slots->stride);
+
+  slots->free_head  = index;
+  slots->count     -= 1;
+}
+
+VGFX_AS_Asset *
+_vgfx_as_slots_asset(_VGFX_AS_SlotMap *slots, u32 index) {
+
+  _VGFX_AS_SlotPage *page = slots->pages[index >> VGFX_AS_SLOT_PAGE_BITS];
+
+  return &page->assets[index & (VGFX_AS_SLOT_PAGE_SIZE - 1)];
+}
+
+void *
+_vgfx_as_slots_value(_VGFX_AS_SlotMap *slots, u32 index) {
+
+  _VGFX_AS_SlotPage *page = slots->pages[index >> VGFX_AS_SLOT_PAGE_BITS];
+
+  return page->values + (usize)(index & (VGFX_AS_SLOT_PAGE_SIZE - 1)) * slots->stride;
+}
+
+// =============================================
+//
+//
+// Asset Archives
+//
+//
+// =============================================
+
+bool 
+_vgfx_as_archive_open(const char *path, _VGFX_AS_Archive *archive) {
+
+  VGFX_ASSERT_NON_NULL(path);
+  VGFX_ASSERT_NON_NULL(archive);
+
+  *archive = (_VGFX_AS_Archive){0};
+
+  if (!vgfx_fs_map(path, &archive->file)) {
+    VGFX_DEBUG_WARN("Failed to map archive, `%s`.\n", path);
+    return false;
+  }
+
+  const usize size = archive->file.size;
+  const VGFX_AS_PackHeader *header = (const VGFX_AS_PackHeader *)archive->file.data;
+
+  // Only archives baked by a matching build are accepted
+  bool valid = size >= sizeof(VGFX_AS_PackHeader) && 
+               header->magic == VGFX_AS_PACK_MAGIC && 
+               header->version == VGFX_AS_PACK_VERSION && 
+               header->glyph_size == sizeof(_VGFX_AS_Glyph) && 
+               header->bucket_count && 
+               !(header->bucket_count & (header->bucket_count - 1));
+
+  valid = valid && 
+          !(header->entries_offset % VGFX_AS_PACK_ALIGNMENT) && 
+          !(header->buckets_offset % VGFX_AS_PACK_ALIGNMENT) && 
+          header->entries_offset <= size && 
+          header->buckets_offset <= size && 
+          (size - header->entries_offset) / sizeof(VGFX_AS_PackEntry) >= header->entry_count && 
+          (size - header->buckets_offset) / sizeof(u32) >= header->bucket_count;
+
+  if (!valid) {
+    VGFX_DEBUG_WARN("Invalid or incompatible archive, `%s`.\n", path);
+
+    vgfx_fs_unmap(&archive->file);
+    return false;
+  }
+
+  archive->header  = header;
+  archive->entries = (const VGFX_AS_PackEntry *)(archive->file.data + header->entries_offset);
+  archive->buckets = (const u32 *)(archive->file.data + header->buckets_offset);
+
+  return true;
+}
+
+const VGFX_AS_PackEntry *
+_vgfx_as_archive_find(VGFX_AS_AssetServer *as, const char *key, const u8 **payload) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(key);
+  VGFX_ASSERT_NON_NULL(payload);
+
+  const u64   hash   = _vgfx_as_cache_hash(key);
+  const usize length = strlen(key) + 1;
+
+  // Newer mounts shadow older ones
+  for (usize i = as->archives.len; i > 0; --i) {
+    const _VGFX_AS_Archive *archive = &vstd_vector_get(_VGFX_AS_Archive, as->archives, i - 1);
+
+    const u8   *base = archive->file.data;
+    const usize size = archive->file.size;
+    const u32   mask = archive->header->bucket_count - 1;
+
+    // Linear probing, an empty bucket ends the chain
+    for (u32 probe = 0, b = (u32)hash & mask; probe <= mask; ++probe, b = (b + 1) & mask) {
+      const u32 slot = archive->buckets[b];
+
+      if (!slot || slot > archive->header->entry_count) {
+        break;
+      }
+
+      const VGFX_AS_PackEntry *entry = &archive->entries[slot - 1];
+
+      if (entry->hash != hash || 
+          entry->key_offset > size || size - entry->key_offset < length || 
+          memcmp(base + entry->key_offset, key, length)) {
+        continue;
+      }
+
+      if (entry->offset > size || size - entry->offset < entry->size) {
+        VGFX_DEBUG_WARN("Archived entry is out of bounds, `%s`.\n", key);
+        return NULL;
+      }
+
+      *payload = base + entry->offset;
+      return entry;
+    }
+  }
+
+  return NULL;
+}
+
+bool 
+_vgfx_as_archive_decode(VGFX_AS_AssetServer *as, VGFX_AS_AssetDesc *desc, 
+                        _VGFX_AS_Decoded *decoded) {
+
+  VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(desc);
+  VGFX_ASSERT_NON_NULL(decoded);
+
+  *decoded = (_VGFX_AS_Decoded){0};
+
+  if (!as->archives.len) {
+    return false;
+  }
+
+  // Entries that don't match what the loaders expect fall back to the loose file
+  const VGFX_AS_PackEntry *entry = NULL;
+  const u8                *payload = NULL;
+  VSTD_String              key = {0};
+
+  switch (desc->type) {
+  case VGFX_ASSET_TYPE_TEXTURE: {
+    key   = _vgfx_as_archive_key(VGFX_AS_PACK_KIND_TEXTURE, desc->texture_path, desc);
+    entry = _vgfx_as_archive_find(as, key.ptr, &payload);
+
+    const bool valid = entry && 
+                       entry->kind == VGFX_AS_PACK_KIND_TEXTURE && 
+                       entry->width > 0 && entry->height > 0 && 
+                       (entry->channel == 1 || entry->channel == 3 || entry->channel == 4) && 
+                       (!desc->texture_array || entry->channel == 4) && 
+                       entry->levels >= 1 && 
+                       entry->levels <= _vgfx_gl_texture_levels(entry->width, entry->height) && 
+                       entry->size == _vgfx_as_archive_texture_size(
+                         entry->width, entry->height, entry->channel, entry->levels);
+
+    if (entry && !valid) {
+      VGFX_DEBUG_WARN("Malformed archived texture, `%s`.\n", key.ptr);
+    }
+
+    vstd_string_free(&key);
+
+    if (!valid) {
+      return false;
+    }
+
+    decoded->pixels  = (u8 *)payload;
+    decoded->width   = entry->width;
+    decoded->height  = entry->height;
+    decoded->channel = entry->channel;
+    decoded->levels  = entry->levels;
+    decoded->opaque  = entry->opaque;
+    break;
+  }
+  case VGFX_ASSET_TYPE_FONT: {
+    key   = _vgfx_as_archive_key(VGFX_AS_PACK_KIND_FONT, desc->font_path, desc);
+    entry = _vgfx_as_archive_find(as, key.ptr, &payload);
+
+    const i32   cap    = (i32)desc->font_range[1] - (i32)desc->font_range[0];
+    const usize glyphs = VGFX_AS_PACK_ALIGN((usize)((cap > 0) ? cap : 0) * sizeof(_VGFX_AS_Glyph));
+
+    const bool valid = entry && 
+                       entry->kind == VGFX_AS_PACK_KIND_FONT && 
+                       cap > 0 && entry->glyph_count == (u32)cap && 
+                       entry->atlas_width > 0 && entry->atlas_height > 0 && 
+                       entry->size == glyphs + (usize)entry->atlas_width * entry->atlas_height;
+
+    if (entry && !valid) {
+      VGFX_DEBUG_WARN("Malformed archived font, `%s`.\n", key.ptr);
+    }
+
+    vstd_string_free(&key);
+
+    if (!valid) {
+      return false;
+    }
+
+    decoded->glyphs               = (_VGFX_AS_Glyph *)payload;
+    decoded->atlas                = (u8 *)payload + glyphs;
+    decoded->atlas_width          = entry->atlas_width;
+    decoded->atlas_height         = entry->atlas_height;
+    decoded->average_glyph_height = entry->average_glyph_height;
+    break;
+  }
+  case VGFX_ASSET_TYPE_SHADER: {
+    const char *paths[2] = {desc->shader_vert_path, desc->shader_frag_path};
+    VGFX_FS_File *files[2] = {&decoded->vert_source, &decoded->frag_source};
+
+    // Both stages come from the same place or neither does
+    for (usize i = 0; i < 2; ++i) {
+      key   = _vgfx_as_archive_key(VGFX_AS_PACK_KIND_FILE, paths[i], desc);
+      entry = _vgfx_as_archive_find(as, key.ptr, &payload);
+
+      vstd_string_free(&key);
+
+      if (!entry || entry->kind != VGFX_AS_PACK_KIND_FILE) {
+        *decoded = (_VGFX_AS_Decoded){0};
+        return false;
+      }
+
+      *files[i] = (VGFX_FS_File){.data = (entry->size) ? payload : NULL, .size = entry->size};
+    }
+    break;
+  }
+  default:
+    return false;
+  }
+
+  decoded->borrowed = true;
+
+  return true;
+}
+
+VSTD_String 
+_vgfx_as_archive_key(VGFX_AS_PackKind kind, const char *path, VGFX_AS_AssetDesc *desc) {
+
+  VGFX_ASSERT_NON_NULL(path);
+
+  // Paths are kept as written, archives are baked on one machine and mounted on another
+  switch (kind) {
+  case VGFX_AS_PACK_KIND_FILE:
+    return vstd_string_format("file|%s", path);
+  case VGFX_AS_PACK_KIND_TEXTURE:
+    VGFX_ASSERT_NON_NULL(desc);
+    return vstd_string_format("texture|%s|%d", path, (i32)desc->texture_array);
+  case VGFX_AS_PACK_KIND_FONT:
+    VGFX_ASSERT_NON_NULL(desc);
+    return vstd_string_format("font|%s|%u|%u|%u", path, desc->font_size, 
+                              desc->font_range[0], desc->font_range[1]);
+  default:
+    VGFX_ABORT("Archive key for this kind is missing.");
+    break;
+  }
+
+  return (VSTD_String){0};
+}
+
+usize 
+_vgfx_as_archive_texture_size(i32 width, i32 height, i32 channel, i32 levels) {
+
+  usize size = 0;
+  for (i32 i = 0; i < levels; ++i) {
+    const usize w = (width >> i) ? (usize)(width >> i) : 1;
+    const usize h = (height >> i) ? (usize)(height >> i) : 1;
+
+    size += w * h * (usize)channel;
+  }
+
+  return size;
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "core.h"
+#include "fs.h"
+
+#include <pthread.h>
 
 // =============================================
 //
@@ -10,31 +13,31 @@
 //
 // =============================================
 
-#ifndef NDEBUG
-#define VGFX_AS_ENABLE_DEBUG_CAST 1
-#else
-#define VGFX_AS_ENABLE_DEBUG_CAST 0
-#endif
-
-#ifndef VGFX_ASSET_CAST
-#define VGFX_ASSET_CAST(asset, asset_type, var)                                \
-  do {                                                                         \
-    var = (typeof(var))asset->handle;                                          \
-                                                                               \
-    VGFX_ASSERT(asset->type == asset_type,                                     \
-                "Failed to cast Asset handle to %d, found %s.", asset->type,   \
-                #asset_type);                                                  \
-  } while (0)
-#endif
-
-#if VGFX_AS_ENABLE_DEBUG_CAST
-#define VGFX_ASSET_DEBUG_CAST VGFX_ASSET_CAST
-#else
-#define VGFX_ASSET_DEBUG_CAST(asset, asset_type, var)                          \
-  do {                                                                         \
-    var = (typeof(var))asset->handle;                                          \
-  } while (0)
-#endif
+// Handles pack the slot index, its generation and the asset type, 0 is never valid
+typedef u32 VGFX_AS_AssetHandle;
+
+#define VGFX_AS_INVALID_ASSET           0
+
+#define VGFX_AS_HANDLE_INDEX_BITS       20
+
+#define VGFX_AS_HANDLE_GENERATION_BITS  10
+
+#define VGFX_AS_HANDLE_INDEX_MASK       ((1u << VGFX_AS_HANDLE_INDEX_BITS) - 1)
+
+#define VGFX_AS_HANDLE_GENERATION_MASK  ((1u << VGFX_AS_HANDLE_GENERATION_BITS) - 1)
+
+#define VGFX_AS_HANDLE_INDEX(h)         ((h) & VGFX_AS_HANDLE_INDEX_MASK)
+
+#define VGFX_AS_HANDLE_GENERATION(h)                                           \
+  (((h) >> VGFX_AS_HANDLE_INDEX_BITS) & VGFX_AS_HANDLE_GENERATION_MASK)
+
+#define VGFX_AS_HANDLE_TYPE(h)                                                 \
+  ((h) >> (VGFX_AS_HANDLE_INDEX_BITS + VGFX_AS_HANDLE_GENERATION_BITS))
+
+#define VGFX_AS_HANDLE_MAKE(type, generation, index)                           \
+  (((u32)(type) << (VGFX_AS_HANDLE_INDEX_BITS + VGFX_AS_HANDLE_GENERATION_BITS)) | \
+   (((u32)(generation) & VGFX_AS_HANDLE_GENERATION_MASK) << VGFX_AS_HANDLE_INDEX_BITS) | \
+   ((u32)(index) & VGFX_AS_HANDLE_INDEX_MASK))
 
 typedef i32 VGFX_AS_AssetType;
 enum VGFX_AS_AssetType {
@@ -45,6 +48,14 @@ enum VGFX_AS_AssetType {
   VGFX_ASSET_TYPE_LAST,
 };
 
+typedef i32 VGFX_AS_AssetState;
+enum VGFX_AS_AssetState {
+  VGFX_ASSET_STATE_LOADING,
+  VGFX_ASSET_STATE_READY,
+  VGFX_ASSET_STATE_FAILED,
+  VGFX_ASSET_STATE_INVALID,  // Stale or foreign handle
+};
+
 typedef struct VGFX_AS_AssetDesc VGFX_AS_AssetDesc;
 struct VGFX_AS_AssetDesc {
   VGFX_AS_AssetType type;
@@ -54,6 +65,8 @@ struct VGFX_AS_AssetDesc {
       const char*   texture_path;
       u32           texture_wrap;
       u32           texture_filter;
+      bool          texture_array; // Falls back to 2D when a page can't hold two layers
+      bool          texture_async; // Stream through the upload queue, 2D textures only
     };
     // VGFX_ASSET_TYPE_FONT
     struct {
@@ -72,13 +85,184 @@ struct VGFX_AS_AssetDesc {
 
 typedef struct VGFX_AS_Asset VGFX_AS_Asset;
 struct VGFX_AS_Asset {
-  i32  type;
-  void *handle;
+  VGFX_AS_AssetState  state;
+  u32                 refs;
+  u32                 generation;
+  bool                alive;
+  VSTD_String         _key;    // Canonical load parameters
+  u64                 _hash;
+  VGFX_AS_AssetHandle _next;   // Cache bucket chain
+  u32                 _free;   // Next free slot while dead
+};
+
+#define VGFX_AS_SLOT_PAGE_BITS    8
+
+#define VGFX_AS_SLOT_PAGE_SIZE    (1u << VGFX_AS_SLOT_PAGE_BITS)
+
+#define VGFX_AS_SLOT_PAGE_COUNT   ((1u << VGFX_AS_HANDLE_INDEX_BITS) >> VGFX_AS_SLOT_PAGE_BITS)
+
+// Typed values live at their slot index next to the asset's bookkeeping
+typedef struct _VGFX_AS_SlotPage _VGFX_AS_SlotPage;
+struct _VGFX_AS_SlotPage {
+  VGFX_AS_Asset assets[VGFX_AS_SLOT_PAGE_SIZE];
+  u8            values[];
+};
+
+// Pages never move once allocated, so resolved values stay valid while other assets load
+typedef struct _VGFX_AS_SlotMap _VGFX_AS_SlotMap;
+struct _VGFX_AS_SlotMap {
+  _VGFX_AS_SlotPage *pages[VGFX_AS_SLOT_PAGE_COUNT];
+  usize              stride;
+  u32                cap;
+  u32                count;
+  u32                free_head;
+};
+
+#define VGFX_AS_TEXTURE_ARRAY_LAYERS   64  // At most 64, layers are tracked in a mask
+
+#define VGFX_AS_TEXTURE_ARRAY_PAGE     (16 << 20) // Bytes of level 0 in one page
+
+#define VGFX_AS_TEXTURE_ARRAY_MIN_SIZE 16
+
+typedef struct VGFX_AS_TextureArray VGFX_AS_TextureArray;
+struct VGFX_AS_TextureArray {
+  u32  handle;
+  u32  size;
+  u32  wrap;
+  u32  filter;
+  u32  capacity; // Layers allocated, fewer for large buckets
+  u32  layers;   // Layers in use
+  u64  used;     // Bit per layer
+  bool dirty;    // Mipmaps are stale
+};
+
+#define VGFX_AS_UPLOAD_RING_SIZE      4
+
+#define VGFX_AS_UPLOAD_SEGMENT_SIZE   (1 << 20)
+
+#define VGFX_AS_UPLOAD_DEFAULT_BUDGET (4 << 20)
+
+typedef struct _VGFX_AS_Upload _VGFX_AS_Upload;
+struct _VGFX_AS_Upload {
+  VGFX_AS_AssetHandle asset;    // Invalid once cancelled
+  u32                 handle;   // Swapped into the texture once complete
+  u8                 *data;
+  u32                 format;
+  i32                 width;
+  i32                 height;
+  i32                 row;      // Next row to stage
+  usize               pitch;
+};
+
+typedef struct _VGFX_AS_UploadQueue _VGFX_AS_UploadQueue;
+struct _VGFX_AS_UploadQueue {
+  VSTD_Vector(_VGFX_AS_Upload) pending;
+  usize                        head;
+  u32                          buffers[VGFX_AS_UPLOAD_RING_SIZE]; // Pixel unpack buffers
+  void                        *fences[VGFX_AS_UPLOAD_RING_SIZE];  // GLsync per buffer
+  usize                        segment;
+  usize                        budget;   // Bytes staged per update
+  u32                          placeholder;
+};
+
+#define VGFX_AS_MAX_WORKERS 16
+
+typedef struct _VGFX_AS_Job _VGFX_AS_Job;
+
+typedef struct _VGFX_AS_WorkerPool _VGFX_AS_WorkerPool;
+struct _VGFX_AS_WorkerPool {
+  pthread_t       threads[VGFX_AS_MAX_WORKERS];
+  usize           count;      // Spawned with the first async load
+  pthread_mutex_t lock;
+  pthread_cond_t  wake;       // Queued job or shutdown
+  pthread_cond_t  finished;   // Decoded job
+  _VGFX_AS_Job   *queued;
+  _VGFX_AS_Job   *queued_tail;
+  _VGFX_AS_Job   *done;
+  usize           pending;    // Submitted and not yet created, GL thread only
+  bool            quit;
+};
+
+#define VGFX_AS_CACHE_MIN_BUCKETS 64
+
+typedef struct _VGFX_AS_Cache _VGFX_AS_Cache;
+struct _VGFX_AS_Cache {
+  VGFX_AS_AssetHandle *buckets;
+  usize                cap;      // Power of two
+  usize                count;
+};
+
+// Archives are written by `vgfx-pack`, every section is 16 byte aligned
+#define VGFX_AS_PACK_MAGIC     0x4b415056u  // "VPAK"
+
+#define VGFX_AS_PACK_VERSION   1
+
+#define VGFX_AS_PACK_ALIGNMENT 16
+
+#define VGFX_AS_PACK_ALIGN(x)                                                  \
+  (((x) + VGFX_AS_PACK_ALIGNMENT - 1) & ~(usize)(VGFX_AS_PACK_ALIGNMENT - 1))
+
+typedef u32 VGFX_AS_PackKind;
+enum VGFX_AS_PackKind {
+  VGFX_AS_PACK_KIND_FILE,      // Raw bytes, shader sources
+  VGFX_AS_PACK_KIND_TEXTURE,   // Decoded pixels, optionally followed by the mip chain
+  VGFX_AS_PACK_KIND_FONT,      // Glyph table followed by the atlas
+};
+
+typedef struct VGFX_AS_PackHeader VGFX_AS_PackHeader;
+struct VGFX_AS_PackHeader {
+  u32 magic;
+  u32 version;
+  u32 glyph_size;      // sizeof(_VGFX_AS_Glyph) when baked
+  u32 entry_count;
+  u32 bucket_count;    // Power of two
+  u32 _reserved;
+  u64 entries_offset;
+  u64 buckets_offset;  // Entry index + 1 per bucket, 0 is empty
+};
+
+typedef struct VGFX_AS_PackEntry VGFX_AS_PackEntry;
+struct VGFX_AS_PackEntry {
+  u64              hash;       // Of the archive key
+  u64              key_offset; // NUL terminated
+  u64              offset;
+  u64              size;
+  VGFX_AS_PackKind kind;
+  union {
+    // VGFX_AS_PACK_KIND_TEXTURE
+    struct {
+      i32          width;
+      i32          height;
+      i32          channel;
+      i32          levels;     // 1 unless baked with mipmaps
+      u32          opaque;
+    };
+    // VGFX_AS_PACK_KIND_FONT
+    struct {
+      i32          atlas_width;
+      i32          atlas_height;
+      u32          glyph_count;
+      f32          average_glyph_height;
+    };
+  };
+};
+
+typedef struct _VGFX_AS_Archive _VGFX_AS_Archive;
+struct _VGFX_AS_Archive {
+  VGFX_FS_File              file;
+  const VGFX_AS_PackHeader *header;
+  const VGFX_AS_PackEntry  *entries;
+  const u32                *buckets;
 };
 
 typedef struct VGFX_AS_AssetServer VGFX_AS_AssetServer;
 struct VGFX_AS_AssetServer {
-  VSTD_Map(VGFX_AS_AssetType, VSTD_Vector(VGFX_AS_Asset *)) assets;
+  _VGFX_AS_SlotMap                  slots[VGFX_ASSET_TYPE_LAST];
+  VSTD_Vector(VGFX_AS_TextureArray) texture_arrays;
+  VSTD_Vector(_VGFX_AS_Archive)     archives;   // Searched newest first
+  _VGFX_AS_UploadQueue              upload;
+  _VGFX_AS_WorkerPool               workers;
+  _VGFX_AS_Cache                    cache;
 };
 
 VGFX_AS_AssetServer *
@@ -87,10 +271,50 @@ vgfx_as_asset_server_new();
 void 
 vgfx_as_asset_server_free(VGFX_AS_AssetServer *as);
 
-VGFX_AS_Asset *
+VGFX_AS_AssetHandle 
 vgfx_as_asset_server_load(VGFX_AS_AssetServer *as, VGFX_AS_AssetDesc *desc);
 
+VGFX_AS_AssetHandle 
+vgfx_as_asset_server_load_async(VGFX_AS_AssetServer *as, VGFX_AS_AssetDesc *desc);
+
+void 
+vgfx_as_asset_server_wait(VGFX_AS_AssetServer *as);
+
+bool 
+vgfx_as_asset_server_mount(VGFX_AS_AssetServer *as, const char *path);
+
+void 
+vgfx_as_asset_server_release(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle);
+
 void 
+vgfx_as_asset_server_update(VGFX_AS_AssetServer *as);
+
+void 
+vgfx_as_asset_server_set_upload_budget(VGFX_AS_AssetServer *as, usize bytes);
+
+VGFX_AS_AssetState 
+vgfx_as_asset_state(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle);
+
+VGFX_AS_AssetHandle 
+_vgfx_as_asset_acquire(VGFX_AS_AssetServer *as, VGFX_AS_AssetDesc *desc, bool *cached);
+
+void 
+_vgfx_as_asset_free(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle);
+
+void 
+_vgfx_as_asset_free_value(VGFX_AS_AssetServer *as, VGFX_AS_AssetType type, void *value);
+
+VGFX_AS_Asset *
+_vgfx_as_asset_get(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle);
+
+void *
+_vgfx_as_asset_value(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle);
+
+void *
+_vgfx_as_asset_resolve(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, 
+                       VGFX_AS_AssetType type);
+
+bool 
 _vgfx_as_validate_asset_path(const char *path);
 
 // =============================================
@@ -108,6 +332,11 @@ struct VGFX_AS_Texture {
   VGFX_AS_TextureHandle handle;
   f32                   size[2];
   u32                   channel;
+  u32                   target;
+  u32                   layer;
+  f32                   uv_scale[2];
+  bool                  opaque;   // No texel has partial alpha
+  bool                  ready;    // Placeholder is bound until the upload completes
 };
 
 typedef struct _VGFX_AS_Glyph _VGFX_AS_Glyph;
@@ -131,22 +360,116 @@ typedef u32 VGFX_AS_ShaderHandle;
 
 typedef u32 VGFX_AS_ShaderProgramHandle;
 
+#define VGFX_AS_MAX_UNIFORM_NAME 64
+
+typedef struct VGFX_AS_Uniform VGFX_AS_Uniform;
+struct VGFX_AS_Uniform {
+  char name[VGFX_AS_MAX_UNIFORM_NAME];
+  u32  hash;
+  i32  location;
+  u32  type;
+  i32  size;      // Element count, arrays are stored once by their base name
+};
+
 typedef struct VGFX_AS_Shader VGFX_AS_Shader;
 struct VGFX_AS_Shader {
-  u32 handle;
+  u32              handle;
+  VGFX_AS_Uniform *uniforms;       // Open addressed, capacity is a power of two
+  usize            uniform_cap;
+  usize            uniform_count;
 };
 
-void *
-_vgfx_as_load_texture(VGFX_AS_AssetDesc *desc);
+const VGFX_AS_Uniform *
+vgfx_as_shader_uniform(VGFX_AS_Shader *handle, const char *name);
 
-void *
-_vgfx_as_load_font(VGFX_AS_AssetDesc *desc);
+// Resolved pointers stay valid until the asset is released, slot pages never move
+VGFX_AS_Texture *
+vgfx_as_texture(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle);
 
-void *
-_vgfx_as_load_shader(VGFX_AS_AssetDesc *desc);
+VGFX_AS_Font *
+vgfx_as_font(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle);
+
+VGFX_AS_Shader *
+vgfx_as_shader(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle);
+
+typedef struct _VGFX_AS_Decoded _VGFX_AS_Decoded;
+struct _VGFX_AS_Decoded {
+  union {
+    // VGFX_ASSET_TYPE_TEXTURE
+    struct {
+      u8             *pixels;
+      i32             width;
+      i32             height;
+      i32             channel;
+      i32             levels;   // Baked mip levels, 0 or 1 generates them
+      bool            opaque;
+    };
+    // VGFX_ASSET_TYPE_FONT
+    struct {
+      u8             *atlas;
+      i32             atlas_width;
+      i32             atlas_height;
+      _VGFX_AS_Glyph *glyphs;   // One per character in range
+      f32             average_glyph_height;
+    };
+    // VGFX_ASSET_TYPE_SHADER
+    struct {
+      VGFX_FS_File    vert_source;
+      VGFX_FS_File    frag_source;
+    };
+  };
+  bool                borrowed; // Points into a mounted archive, never freed
+};
+
+bool 
+_vgfx_as_load(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, VGFX_AS_AssetDesc *desc, 
+              _VGFX_AS_Decoded *decoded);
+
+bool 
+_vgfx_as_load_texture(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, 
+                      VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded);
+
+bool 
+_vgfx_as_load_texture_layer(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, 
+                            VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded);
+
+u32 
+_vgfx_as_texture_array_capacity(u32 size);
 
 void 
-_vgfx_as_free_texture(VGFX_AS_Texture *handle);
+_vgfx_as_texture_arrays_commit(VGFX_AS_AssetServer *as);
+
+bool 
+_vgfx_as_load_font(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, 
+                   VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded);
+
+bool 
+_vgfx_as_load_shader(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle, 
+                     VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded);
+
+bool 
+_vgfx_as_decode(VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded);
+
+bool 
+_vgfx_as_decode_texture(VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded);
+
+bool 
+_vgfx_as_decode_font(VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded);
+
+bool 
+_vgfx_as_decode_shader(VGFX_AS_AssetDesc *desc, _VGFX_AS_Decoded *decoded);
+
+void 
+_vgfx_as_decoded_free(VGFX_AS_AssetType type, _VGFX_AS_Decoded *decoded);
+
+bool 
+_vgfx_as_texture_opaque(const u8 *data, i32 width, i32 height, i32 channel);
+
+void 
+_vgfx_as_free_texture(VGFX_AS_AssetServer *as, VGFX_AS_Texture *handle);
+
+void 
+_vgfx_as_free_texture_array(VGFX_AS_TextureArray *array);
 
 void 
 _vgfx_as_free_font(VGFX_AS_Font *handle);
@@ -154,8 +477,164 @@ _vgfx_as_free_font(VGFX_AS_Font *handle);
 void 
 _vgfx_as_free_shader(VGFX_AS_Shader *handle);
 
+void 
+_vgfx_as_shader_reflect(VGFX_AS_Shader *handle);
+
 u32 
-_vgfx_as_compile_shader(u32 type, const char** path);
+_vgfx_as_uniform_hash(const char *name);
+
+bool 
+_vgfx_as_uniform_sampler(u32 type);
+
+u32 
+_vgfx_as_compile_shader(u32 type, const VGFX_FS_File *source);
 
 u32 
 _vgfx_as_compile_shader_program(VGFX_AS_ShaderHandle *vec, usize len);
+
+// =============================================
+//
+//
+// Texture Uploads
+//
+//
+// =============================================
+
+void 
+_vgfx_as_upload_init(_VGFX_AS_UploadQueue *queue);
+
+void 
+_vgfx_as_upload_free(VGFX_AS_AssetServer *as);
+
+void 
+_vgfx_as_upload_push(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle asset, u32 handle, 
+                     u8 *data, u32 format, i32 width, i32 height, i32 channel);
+
+void 
+_vgfx_as_upload_cancel(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle asset);
+
+bool 
+_vgfx_as_upload_step(VGFX_AS_AssetServer *as, usize *budget);
+
+void 
+_vgfx_as_upload_complete(VGFX_AS_AssetServer *as, _VGFX_AS_Upload *upload);
+
+// =============================================
+//
+//
+// Asset Workers
+//
+//
+// =============================================
+
+struct _VGFX_AS_Job {
+  VGFX_AS_AssetHandle asset;
+  VGFX_AS_AssetDesc  desc;      // Paths point into `paths`
+  char              *paths[2];
+  _VGFX_AS_Decoded   decoded;
+  bool               failed;
+  _VGFX_AS_Job      *next;
+};
+
+void 
+_vgfx_as_workers_init(_VGFX_AS_WorkerPool *pool);
+
+void 
+_vgfx_as_workers_free(_VGFX_AS_WorkerPool *pool);
+
+void 
+_vgfx_as_workers_submit(_VGFX_AS_WorkerPool *pool, _VGFX_AS_Job *job);
+
+_VGFX_AS_Job *
+_vgfx_as_workers_drain(_VGFX_AS_WorkerPool *pool, bool block);
+
+void 
+_vgfx_as_workers_finish(VGFX_AS_AssetServer *as, _VGFX_AS_Job *jobs);
+
+void *
+_vgfx_as_worker_main(void *arg);
+
+_VGFX_AS_Job *
+_vgfx_as_job_new(VGFX_AS_AssetHandle asset, VGFX_AS_AssetDesc *desc);
+
+void 
+_vgfx_as_job_free(_VGFX_AS_Job *job);
+
+// =============================================
+//
+//
+// Asset Cache
+//
+//
+// =============================================
+
+void 
+_vgfx_as_cache_init(_VGFX_AS_Cache *cache);
+
+void 
+_vgfx_as_cache_free(_VGFX_AS_Cache *cache);
+
+VGFX_AS_AssetHandle 
+_vgfx_as_cache_find(VGFX_AS_AssetServer *as, const char *key, u64 hash);
+
+void 
+_vgfx_as_cache_insert(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle);
+
+void 
+_vgfx_as_cache_remove(VGFX_AS_AssetServer *as, VGFX_AS_AssetHandle handle);
+
+VSTD_String 
+_vgfx_as_cache_key(VGFX_AS_AssetDesc *desc);
+
+u64 
+_vgfx_as_cache_hash(const char *key);
+
+// =============================================
+//
+//
+// Asset Slots
+//
+//
+// =============================================
+
+void 
+_vgfx_as_slots_init(_VGFX_AS_SlotMap *slots, usize stride);
+
+void 
+_vgfx_as_slots_free(_VGFX_AS_SlotMap *slots);
+
+u32 
+_vgfx_as_slots_alloc(_VGFX_AS_SlotMap *slots);
+
+void 
+_vgfx_as_slots_release(_VGFX_AS_SlotMap *slots, u32 index);
+
+VGFX_AS_Asset *
+_vgfx_as_slots_asset(_VGFX_AS_SlotMap *slots, u32 index);
+
+void *
+_vgfx_as_slots_value(_VGFX_AS_SlotMap *slots, u32 index);
+
+// =============================================
+//
+//
+// Asset Archives
+//
+//
+// =============================================
+
+bool 
+_vgfx_as_archive_open(const char *path, _VGFX_AS_Archive *archive);
+
+const VGFX_AS_PackEntry *
+_vgfx_as_archive_find(VGFX_AS_AssetServer *as, const char *key, const u8 **payload);
+
+bool 
+_vgfx_as_archive_decode(VGFX_AS_AssetServer *as, VGFX_AS_AssetDesc *desc, 
+                        _VGFX_AS_Decoded *decoded);
+
+VSTD_String 
+_vgfx_as_archive_key(VGFX_AS_PackKind kind, const char *path, VGFX_AS_AssetDesc *desc);
+
+usize 
+_vgfx_as_archive_texture_size(i32 width, i32 height, i32 channel, i32 levels);
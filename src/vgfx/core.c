@@ -3,6 +3,12 @@
 #define B_STACKTRACE_IMPL
 #include <b_stacktrace.h>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
 // =============================================
 //
 //
@@ -72,3 +78,128 @@ _vgfx_debug_warn(const char *msg, ...) {
   vprintf(msg, va_args);
   va_end(va_args);
 }
+
+// =============================================
+//
+//
+// Profiler
+//
+//
+// =============================================
+
+static _VGFX_ProfileRing *s_profile_rings;
+
+static u32 s_profile_thread_count;
+
+static VGFX_THREAD_LOCAL _VGFX_ProfileRing *s_profile_thread_ring;
+
+u64 
+vgfx_clock_ns() {
+
+#if defined(_WIN32)
+  LARGE_INTEGER freq, now;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&now);
+
+  return (u64)((now.QuadPart / freq.QuadPart) * 1000000000ULL + 
+               (now.QuadPart % freq.QuadPart) * 1000000000ULL / freq.QuadPart);
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+#endif
+}
+
+bool 
+vgfx_profiler_dump(const char *path) {
+
+  VGFX_ASSERT_NON_NULL(path);
+
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    VGFX_DEBUG_WARN("Failed to open trace file, `%s`.\n", path);
+    return false;
+  }
+
+  fprintf(file, "{\"traceEvents\":[\n");
+
+  bool first = true;
+
+  _VGFX_ProfileRing *ring = __atomic_load_n(&s_profile_rings, __ATOMIC_ACQUIRE);
+  for (; ring; ring = ring->next) {
+    const u64 head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    const u64 tail = (head > VGFX_PROFILE_RING_SIZE) ? head - VGFX_PROFILE_RING_SIZE : 0;
+
+    // Only the newest events survive a wrapped ring
+    for (u64 i = tail; i < head; ++i) {
+      const _VGFX_ProfileEvent *event = &ring->events[i % VGFX_PROFILE_RING_SIZE];
+
+      fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,"
+                    "\"ts\":%.3f,\"dur\":%.3f}", 
+              (first) ? "" : ",\n", event->name, ring->thread, 
+              event->start / 1000.0, (event->end - event->start) / 1000.0);
+
+      first = false;
+    }
+  }
+
+  fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+  fclose(file);
+
+  return true;
+}
+
+void 
+vgfx_profiler_free() {
+
+  _VGFX_ProfileRing *ring = __atomic_exchange_n(&s_profile_rings, NULL, __ATOMIC_ACQ_REL);
+
+  while (ring) {
+    _VGFX_ProfileRing *next = ring->next;
+    free(ring);
+    ring = next;
+  }
+
+  s_profile_thread_ring = NULL;
+}
+
+void 
+_vgfx_profile_zone(const char *name, u64 start, u64 end) {
+
+  _VGFX_ProfileRing *ring = _vgfx_profile_ring();
+
+  // Single writer per ring, publish the slot after it is filled
+  const u64 head = ring->head;
+
+  ring->events[head % VGFX_PROFILE_RING_SIZE] = (_VGFX_ProfileEvent){
+    .name  = name,
+    .start = start,
+    .end   = end,
+  };
+
+  __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+_VGFX_ProfileRing *
+_vgfx_profile_ring() {
+
+  if (s_profile_thread_ring) {
+    return s_profile_thread_ring;
+  }
+
+  _VGFX_ProfileRing *ring = (_VGFX_ProfileRing *)calloc(1, sizeof(_VGFX_ProfileRing));
+  VGFX_ASSERT(ring, "Failed to allocate profiler ring.");
+
+  ring->thread = __atomic_fetch_add(&s_profile_thread_count, 1, __ATOMIC_RELAXED);
+
+  // Lock-free push onto the global ring list
+  ring->next = __atomic_load_n(&s_profile_rings, __ATOMIC_RELAXED);
+  while (!__atomic_compare_exchange_n(&s_profile_rings, &ring->next, ring, true, 
+                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+  }
+
+  s_profile_thread_ring = ring;
+
+  return ring;
+}
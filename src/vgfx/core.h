@@ -8,6 +8,12 @@
 
 #define VGFX_UNUSED(expr) ((void)(expr))
 
+#if defined(_MSC_VER)
+#define VGFX_THREAD_LOCAL __declspec(thread)
+#else
+#define VGFX_THREAD_LOCAL __thread
+#endif
+
 // =============================================
 //
 //
@@ -88,3 +94,61 @@ _vgfx_debug_print(const char *msg, ...);
 
 void 
 _vgfx_debug_warn(const char *msg, ...);
+
+// =============================================
+//
+//
+// Profiler
+//
+//
+// =============================================
+
+#ifndef VGFX_ENABLE_PROFILER
+#ifndef NDEBUG
+#define VGFX_ENABLE_PROFILER 1
+#else
+#define VGFX_ENABLE_PROFILER 0
+#endif
+#endif
+
+#define VGFX_PROFILE_RING_SIZE 65536
+
+#if VGFX_ENABLE_PROFILER
+#define VGFX_PROFILE_BEGIN(zone)                                               \
+  const u64 _vgfx_zone_##zone = vgfx_clock_ns()
+#define VGFX_PROFILE_END(zone)                                                 \
+  _vgfx_profile_zone(#zone, _vgfx_zone_##zone, vgfx_clock_ns())
+#else
+#define VGFX_PROFILE_BEGIN(zone) (void)0
+#define VGFX_PROFILE_END(zone) (void)0
+#endif
+
+typedef struct _VGFX_ProfileEvent _VGFX_ProfileEvent;
+struct _VGFX_ProfileEvent {
+  const char *name;
+  u64         start;
+  u64         end;
+};
+
+typedef struct _VGFX_ProfileRing _VGFX_ProfileRing;
+struct _VGFX_ProfileRing {
+  _VGFX_ProfileEvent  events[VGFX_PROFILE_RING_SIZE];
+  u64                 head;
+  u32                 thread;
+  _VGFX_ProfileRing  *next;
+};
+
+u64 
+vgfx_clock_ns();
+
+bool 
+vgfx_profiler_dump(const char *path);
+
+void 
+vgfx_profiler_free();
+
+void 
+_vgfx_profile_zone(const char *name, u64 start, u64 end);
+
+_VGFX_ProfileRing *
+_vgfx_profile_ring();
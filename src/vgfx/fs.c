@@ -0,0 +1,80 @@
+#include "fs.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// =============================================
+//
+//
+// Mapped Files
+//
+//
+// =============================================
+
+bool 
+vgfx_fs_exists(const char *path) {
+
+  VGFX_ASSERT_NON_NULL(path);
+
+  struct stat st;
+  if (stat(path, &st) || !S_ISREG(st.st_mode)) {
+    return false;
+  }
+
+  return !access(path, R_OK);
+}
+
+bool 
+vgfx_fs_map(const char *path, VGFX_FS_File *file) {
+
+  VGFX_ASSERT_NON_NULL(path);
+  VGFX_ASSERT_NON_NULL(file);
+
+  *file = (VGFX_FS_File){0};
+
+  i32 fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) || !S_ISREG(st.st_mode)) {
+    close(fd);
+    return false;
+  }
+
+  // Zero length mappings are invalid, an empty file is still a valid file
+  if (st.st_size == 0) {
+    close(fd);
+    return true;
+  }
+
+  void *data = mmap(NULL, (usize)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  // Every byte is about to be touched, start faulting them in now
+  madvise(data, (usize)st.st_size, MADV_WILLNEED);
+
+  file->data = (const u8 *)data;
+  file->size = (usize)st.st_size;
+
+  return true;
+}
+
+void 
+vgfx_fs_unmap(VGFX_FS_File *file) {
+
+  VGFX_ASSERT_NON_NULL(file);
+
+  if (file->data) {
+    munmap((void *)file->data, file->size);
+  }
+
+  *file = (VGFX_FS_File){0};
+}
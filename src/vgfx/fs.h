@@ -0,0 +1,26 @@
+#pragma once
+
+#include "core.h"
+
+// =============================================
+//
+//
+// Mapped Files
+//
+//
+// =============================================
+
+typedef struct VGFX_FS_File VGFX_FS_File;
+struct VGFX_FS_File {
+  const u8 *data;   // Read-only, NULL for empty files
+  usize     size;
+};
+
+bool 
+vgfx_fs_exists(const char *path);
+
+bool 
+vgfx_fs_map(const char *path, VGFX_FS_File *file);
+
+void 
+vgfx_fs_unmap(VGFX_FS_File *file);
@@ -1,7 +1,432 @@
 #include "gl.h"
 #include "asset.h"
 
-static VGFX_AS_ShaderProgramHandle s_gl_bound_shader;
+typedef void (APIENTRYP _VGFX_GL_PFNBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, 
+                                                       const void *data, GLbitfield flags);
+
+typedef void (APIENTRYP _VGFX_GL_PFNMULTIDRAWELEMENTSINDIRECTPROC)(
+  GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride);
+
+// Direct state access entry points, GL 4.5 or ARB_direct_state_access
+typedef struct _VGFX_GL_DSA _VGFX_GL_DSA;
+struct _VGFX_GL_DSA {
+  void   (APIENTRYP create_buffers)(GLsizei n, GLuint *buffers);
+  void   (APIENTRYP named_buffer_data)(GLuint buffer, GLsizeiptr size, const void *data, 
+                                       GLenum usage);
+  void   (APIENTRYP named_buffer_sub_data)(GLuint buffer, GLintptr offset, GLsizeiptr size, 
+                                           const void *data);
+  void   (APIENTRYP named_buffer_storage)(GLuint buffer, GLsizeiptr size, const void *data, 
+                                          GLbitfield flags);
+  void * (APIENTRYP map_named_buffer_range)(GLuint buffer, GLintptr offset, GLsizeiptr length, 
+                                            GLbitfield access);
+  void   (APIENTRYP flush_mapped_named_buffer_range)(GLuint buffer, GLintptr offset, 
+                                                     GLsizeiptr length);
+  GLboolean (APIENTRYP unmap_named_buffer)(GLuint buffer);
+
+  void   (APIENTRYP create_vertex_arrays)(GLsizei n, GLuint *arrays);
+  void   (APIENTRYP vertex_array_vertex_buffer)(GLuint vaobj, GLuint bindingindex, GLuint buffer, 
+                                                GLintptr offset, GLsizei stride);
+  void   (APIENTRYP vertex_array_element_buffer)(GLuint vaobj, GLuint buffer);
+  void   (APIENTRYP enable_vertex_array_attrib)(GLuint vaobj, GLuint index);
+  void   (APIENTRYP vertex_array_attrib_format)(GLuint vaobj, GLuint attribindex, GLint size, 
+                                                GLenum type, GLboolean normalized, 
+                                                GLuint relativeoffset);
+  void   (APIENTRYP vertex_array_attrib_i_format)(GLuint vaobj, GLuint attribindex, GLint size, 
+                                                  GLenum type, GLuint relativeoffset);
+  void   (APIENTRYP vertex_array_attrib_binding)(GLuint vaobj, GLuint attribindex, 
+                                                 GLuint bindingindex);
+  void   (APIENTRYP vertex_array_binding_divisor)(GLuint vaobj, GLuint bindingindex, 
+                                                  GLuint divisor);
+
+  void   (APIENTRYP create_textures)(GLenum target, GLsizei n, GLuint *textures);
+  void   (APIENTRYP texture_parameteri)(GLuint texture, GLenum pname, GLint param);
+  void   (APIENTRYP texture_storage_2d)(GLuint texture, GLsizei levels, GLenum internalformat, 
+                                        GLsizei width, GLsizei height);
+  void   (APIENTRYP texture_storage_3d)(GLuint texture, GLsizei levels, GLenum internalformat, 
+                                        GLsizei width, GLsizei height, GLsizei depth);
+  void   (APIENTRYP texture_sub_image_2d)(GLuint texture, GLint level, GLint xoffset, 
+                                          GLint yoffset, GLsizei width, GLsizei height, 
+                                          GLenum format, GLenum type, const void *pixels);
+  void   (APIENTRYP texture_sub_image_3d)(GLuint texture, GLint level, GLint xoffset, 
+                                          GLint yoffset, GLint zoffset, GLsizei width, 
+                                          GLsizei height, GLsizei depth, GLenum format, 
+                                          GLenum type, const void *pixels);
+  void   (APIENTRYP generate_texture_mipmap)(GLuint texture);
+};
+
+// Uniform writes to `src` are repeated on `dst` at the linked locations
+typedef struct _VGFX_GL_UniformMirror _VGFX_GL_UniformMirror;
+struct _VGFX_GL_UniformMirror {
+  VGFX_AS_ShaderProgramHandle src;
+  VGFX_AS_ShaderProgramHandle dst;
+  VGFX_GL_UniformLink        *links;
+  usize                       count;
+  usize                       capacity;
+  bool                        active;
+};
+
+static VGFX_AS_ShaderProgramHandle   s_gl_bound_shader;
+
+static _VGFX_GL_UniformMirror        s_gl_mirror;
+
+static VGFX_GL_Caps                  s_gl_caps;
+
+static _VGFX_GL_State                s_gl_state;
+
+static _VGFX_GL_DSA                  s_gl_dsa;
+
+static _VGFX_GL_PFNBUFFERSTORAGEPROC s_gl_buffer_storage;
+
+static _VGFX_GL_PFNMULTIDRAWELEMENTSINDIRECTPROC s_gl_multi_draw_elements_indirect;
+
+// =============================================
+//
+//
+// Capabilities
+//
+//
+// =============================================
+
+const VGFX_GL_Caps *
+vgfx_gl_caps() {
+
+  return &s_gl_caps;
+}
+
+void
+_vgfx_gl_load_caps() {
+
+  vgfx_gl_state_invalidate();
+
+  i32 major, minor;
+  glGetIntegerv(GL_MAJOR_VERSION, &major);
+  glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+  s_gl_caps.version = VGFX_GL_VERSION(major, minor);
+
+  // Functions beyond the loaded 3.3 core profile
+  s_gl_buffer_storage = 
+    (_VGFX_GL_PFNBUFFERSTORAGEPROC)glfwGetProcAddress("glBufferStorage");
+
+  s_gl_caps.buffer_storage = 
+    s_gl_buffer_storage && 
+    (s_gl_caps.version >= VGFX_GL_VERSION(4, 4) || 
+     _vgfx_gl_has_extension("GL_ARB_buffer_storage"));
+
+  s_gl_multi_draw_elements_indirect = (_VGFX_GL_PFNMULTIDRAWELEMENTSINDIRECTPROC)
+    glfwGetProcAddress("glMultiDrawElementsIndirect");
+
+  s_gl_caps.multi_draw_indirect = 
+    s_gl_multi_draw_elements_indirect && 
+    (s_gl_caps.version >= VGFX_GL_VERSION(4, 3) || 
+     _vgfx_gl_has_extension("GL_ARB_multi_draw_indirect"));
+
+  s_gl_caps.shader_draw_parameters = 
+    s_gl_caps.version >= VGFX_GL_VERSION(4, 6) || 
+    _vgfx_gl_has_extension("GL_ARB_shader_draw_parameters");
+
+  s_gl_caps.pipeline_statistics = 
+    s_gl_caps.version >= VGFX_GL_VERSION(4, 6) || 
+    _vgfx_gl_has_extension("GL_ARB_pipeline_statistics_query");
+
+  s_gl_caps.direct_state_access = 
+    _vgfx_gl_load_dsa() && 
+    (s_gl_caps.version >= VGFX_GL_VERSION(4, 5) || 
+     _vgfx_gl_has_extension("GL_ARB_direct_state_access"));
+
+  i32 units;
+  glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &units);
+
+  s_gl_caps.max_texture_units = (u32)units;
+
+  i32 texture_size, array_layers;
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &texture_size);
+  glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &array_layers);
+
+  s_gl_caps.max_texture_size = (u32)texture_size;
+  s_gl_caps.max_array_layers = (u32)array_layers;
+
+  // Indirect submission needs gl_DrawID to fetch per-draw data
+  s_gl_caps.tier = 
+    (s_gl_caps.multi_draw_indirect && s_gl_caps.shader_draw_parameters) 
+      ? VGFX_GL_TIER_INDIRECT 
+      : VGFX_GL_TIER_BASE;
+}
+
+bool
+_vgfx_gl_load_dsa() {
+
+  #define _VGFX_GL_LOAD(field, name)                                           \
+    s_gl_dsa.field = (typeof(s_gl_dsa.field))glfwGetProcAddress(name);         \
+    loaded = loaded && s_gl_dsa.field
+
+  bool loaded = true;
+
+  _VGFX_GL_LOAD(create_buffers,                  "glCreateBuffers");
+  _VGFX_GL_LOAD(named_buffer_data,               "glNamedBufferData");
+  _VGFX_GL_LOAD(named_buffer_sub_data,           "glNamedBufferSubData");
+  _VGFX_GL_LOAD(named_buffer_storage,            "glNamedBufferStorage");
+  _VGFX_GL_LOAD(map_named_buffer_range,          "glMapNamedBufferRange");
+  _VGFX_GL_LOAD(flush_mapped_named_buffer_range, "glFlushMappedNamedBufferRange");
+  _VGFX_GL_LOAD(unmap_named_buffer,              "glUnmapNamedBuffer");
+  _VGFX_GL_LOAD(create_vertex_arrays,            "glCreateVertexArrays");
+  _VGFX_GL_LOAD(vertex_array_vertex_buffer,      "glVertexArrayVertexBuffer");
+  _VGFX_GL_LOAD(vertex_array_element_buffer,     "glVertexArrayElementBuffer");
+  _VGFX_GL_LOAD(enable_vertex_array_attrib,      "glEnableVertexArrayAttrib");
+  _VGFX_GL_LOAD(vertex_array_attrib_format,      "glVertexArrayAttribFormat");
+  _VGFX_GL_LOAD(vertex_array_attrib_i_format,    "glVertexArrayAttribIFormat");
+  _VGFX_GL_LOAD(vertex_array_attrib_binding,     "glVertexArrayAttribBinding");
+  _VGFX_GL_LOAD(vertex_array_binding_divisor,    "glVertexArrayBindingDivisor");
+  _VGFX_GL_LOAD(create_textures,                 "glCreateTextures");
+  _VGFX_GL_LOAD(texture_parameteri,              "glTextureParameteri");
+  _VGFX_GL_LOAD(texture_storage_2d,              "glTextureStorage2D");
+  _VGFX_GL_LOAD(texture_storage_3d,              "glTextureStorage3D");
+  _VGFX_GL_LOAD(texture_sub_image_2d,            "glTextureSubImage2D");
+  _VGFX_GL_LOAD(texture_sub_image_3d,            "glTextureSubImage3D");
+  _VGFX_GL_LOAD(generate_texture_mipmap,         "glGenerateTextureMipmap");
+
+  #undef _VGFX_GL_LOAD
+
+  return loaded;
+}
+
+bool
+_vgfx_gl_has_extension(const char *name) {
+
+  i32 count;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+  for (i32 i = 0; i < count; ++i) {
+    const char *ext = (const char *)glGetStringi(GL_EXTENSIONS, i);
+
+    if (ext && !strcmp(ext, name)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// =============================================
+//
+//
+// State
+//
+//
+// =============================================
+
+void 
+vgfx_gl_bind_vertex_array(u32 handle) {
+
+  if (_vgfx_gl_state_elide(&s_gl_state.vertex_array, handle)) {
+    return;
+  }
+
+  glBindVertexArray(handle);
+}
+
+void 
+vgfx_gl_bind_buffer(u32 target, u32 handle) {
+
+  // Element bindings belong to the bound vertex array and aren't shadowed
+  i32 slot = _vgfx_gl_state_buffer_slot(target);
+
+  if (slot >= 0 && _vgfx_gl_state_elide(&s_gl_state.buffers[slot], handle)) {
+    return;
+  }
+
+  glBindBuffer(target, handle);
+}
+
+void 
+vgfx_gl_bind_texture(u32 target, u32 handle, u32 unit) {
+
+  i32 slot = _vgfx_gl_state_texture_slot(target);
+
+  if (slot >= 0 && unit < VGFX_GL_STATE_MAX_TEXTURE_UNIT && 
+      _vgfx_gl_state_elide(&s_gl_state.textures[unit][slot], handle)) {
+    return;
+  }
+
+  if (!_vgfx_gl_state_elide(&s_gl_state.active_unit, unit)) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+  }
+
+  glBindTexture(target, handle);
+}
+
+void 
+vgfx_gl_set_blend(bool enable) {
+
+  if (_vgfx_gl_state_elide(&s_gl_state.blend, enable)) {
+    return;
+  }
+
+  if (enable) {
+    glEnable(GL_BLEND);
+  } else {
+    glDisable(GL_BLEND);
+  }
+}
+
+void 
+vgfx_gl_set_blend_func(u32 src, u32 dst) {
+
+  s_gl_state.crn.calls += 1;
+
+  if (s_gl_state.blend_func[0] == src && s_gl_state.blend_func[1] == dst) {
+    s_gl_state.crn.elided += 1;
+    return;
+  }
+
+  s_gl_state.blend_func[0] = src;
+  s_gl_state.blend_func[1] = dst;
+
+  glBlendFunc(src, dst);
+}
+
+void 
+vgfx_gl_set_depth_test(bool enable) {
+
+  if (_vgfx_gl_state_elide(&s_gl_state.depth_test, enable)) {
+    return;
+  }
+
+  if (enable) {
+    glEnable(GL_DEPTH_TEST);
+  } else {
+    glDisable(GL_DEPTH_TEST);
+  }
+}
+
+void 
+vgfx_gl_set_depth_mask(bool enable) {
+
+  if (_vgfx_gl_state_elide(&s_gl_state.depth_mask, enable)) {
+    return;
+  }
+
+  glDepthMask(enable ? GL_TRUE : GL_FALSE);
+}
+
+void 
+vgfx_gl_set_viewport(i32 x, i32 y, i32 w, i32 h) {
+
+  const i32 viewport[4] = {x, y, w, h};
+
+  s_gl_state.crn.calls += 1;
+
+  if (!memcmp(s_gl_state.viewport, viewport, sizeof(viewport))) {
+    s_gl_state.crn.elided += 1;
+    return;
+  }
+
+  memcpy(s_gl_state.viewport, viewport, sizeof(viewport));
+
+  glViewport(x, y, w, h);
+}
+
+void 
+vgfx_gl_delete_texture(u32 handle) {
+
+  // Deleted names can be handed out again, forget every unit holding this one
+  for (usize i = 0; i < VGFX_GL_STATE_MAX_TEXTURE_UNIT; ++i) {
+    for (usize j = 0; j < 2; ++j) {
+      if (s_gl_state.textures[i][j] == handle) {
+        s_gl_state.textures[i][j] = VGFX_GL_STATE_UNKNOWN;
+      }
+    }
+  }
+
+  glDeleteTextures(1, &handle);
+}
+
+void 
+vgfx_gl_delete_shader_program(u32 handle) {
+
+  if (s_gl_state.program == handle) {
+    s_gl_state.program = VGFX_GL_STATE_UNKNOWN;
+  }
+
+  if (s_gl_mirror.src == handle || s_gl_mirror.dst == handle) {
+    vgfx_gl_uniform_mirror(VGFX_GL_INVALID_HANDLE, VGFX_GL_INVALID_HANDLE, NULL, 0);
+  }
+
+  glDeleteProgram(handle);
+}
+
+void 
+vgfx_gl_state_invalidate() {
+
+  const VGFX_GL_StateStats crn   = s_gl_state.crn;
+  const VGFX_GL_StateStats frame = s_gl_state.frame;
+
+  // Every field reads as unknown, so the next change always reaches the driver
+  memset(&s_gl_state, 0xFF, sizeof(s_gl_state));
+
+  s_gl_state.crn   = crn;
+  s_gl_state.frame = frame;
+}
+
+void 
+vgfx_gl_state_end_frame() {
+
+  s_gl_state.frame = s_gl_state.crn;
+  s_gl_state.crn   = (VGFX_GL_StateStats){0};
+}
+
+const VGFX_GL_StateStats *
+vgfx_gl_state_stats() {
+
+  return &s_gl_state.frame;
+}
+
+i32 
+_vgfx_gl_state_buffer_slot(u32 target) {
+
+  switch (target) {
+  case GL_ARRAY_BUFFER:
+    return 0;
+  case GL_COPY_WRITE_BUFFER:
+    return 1;
+  case GL_DRAW_INDIRECT_BUFFER:
+    return 2;
+  case GL_PIXEL_UNPACK_BUFFER:
+    return 3;
+  case GL_UNIFORM_BUFFER:
+    return 4;
+  default:
+    return -1;
+  }
+}
+
+i32 
+_vgfx_gl_state_texture_slot(u32 target) {
+
+  switch (target) {
+  case GL_TEXTURE_2D:
+    return 0;
+  case GL_TEXTURE_2D_ARRAY:
+    return 1;
+  default:
+    return -1;
+  }
+}
+
+bool 
+_vgfx_gl_state_elide(u32 *cached, u32 value) {
+
+  s_gl_state.crn.calls += 1;
+
+  if (*cached == value) {
+    s_gl_state.crn.elided += 1;
+    return true;
+  }
+
+  *cached = value;
+
+  return false;
+}
 
 // =============================================
 //
@@ -15,7 +440,11 @@ VGFX_GL_Buffer
 vgfx_gl_buffer_create(u32 type) {
 
   VGFX_GL_Buffer buff;
-  glGenBuffers(1, &buff.handle);
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.create_buffers(1, &buff.handle);
+  } else {
+    glGenBuffers(1, &buff.handle);
+  }
 
   buff.size = 0;
   buff.type = type;
@@ -28,6 +457,13 @@ vgfx_gl_buffer_delete(VGFX_GL_Buffer *buff) {
 
   VGFX_ASSERT_NON_NULL(buff);
 
+  // Deleting a bound buffer resets its bindings to zero
+  for (usize i = 0; i < VGFX_GL_STATE_BUFFER_COUNT; ++i) {
+    if (s_gl_state.buffers[i] == buff->handle) {
+      s_gl_state.buffers[i] = VGFX_GL_INVALID_HANDLE;
+    }
+  }
+
   glDeleteBuffers(1, &buff->handle);
 
   buff->handle = VGFX_GL_INVALID_HANDLE;
@@ -41,9 +477,13 @@ vgfx_gl_buffer_data(VGFX_GL_Buffer *buff, u32 usage, usize size, void *data) {
 
   buff->size = size;
 
-  glBindBuffer(buff->type, buff->handle);
-  glBufferData(buff->type, size, data, usage);
-  glBindBuffer(buff->type, VGFX_GL_INVALID_HANDLE);
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.named_buffer_data(buff->handle, size, data, usage);
+    return;
+  }
+
+  u32 target = _vgfx_gl_buffer_bind(buff);
+  glBufferData(target, size, data, usage);
 }
 
 void 
@@ -51,18 +491,102 @@ vgfx_gl_buffer_sub_data(VGFX_GL_Buffer *buff, usize offset, usize size, void *da
   
   VGFX_ASSERT_NON_NULL(buff);
 
-  glBindBuffer(buff->type, buff->handle);
-  glBufferSubData(buff->type, offset, size, data);
-  glBindBuffer(buff->type, VGFX_GL_INVALID_HANDLE);
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.named_buffer_sub_data(buff->handle, offset, size, data);
+    return;
+  }
+
+  u32 target = _vgfx_gl_buffer_bind(buff);
+  glBufferSubData(target, offset, size, data);
+}
+
+void 
+vgfx_gl_buffer_storage(VGFX_GL_Buffer *buff, usize size, void *data, u32 flags) {
+
+  VGFX_ASSERT_NON_NULL(buff);
+  VGFX_ASSERT(s_gl_caps.buffer_storage, "Immutable buffer storage is not supported.");
+
+  buff->size = size;
+
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.named_buffer_storage(buff->handle, size, data, flags);
+    return;
+  }
+
+  u32 target = _vgfx_gl_buffer_bind(buff);
+  s_gl_buffer_storage(target, size, data, flags);
+}
+
+void *
+vgfx_gl_buffer_map_range(VGFX_GL_Buffer *buff, usize offset, usize size, u32 access) {
+
+  VGFX_ASSERT_NON_NULL(buff);
+  VGFX_DEBUG_ASSERT(offset + size <= buff->size, 
+                    "Mapped range exceeds the buffer size, `%lu`.", buff->size);
+
+  void *ptr;
+  if (s_gl_caps.direct_state_access) {
+    ptr = s_gl_dsa.map_named_buffer_range(buff->handle, offset, size, access);
+  } else {
+    ptr = glMapBufferRange(_vgfx_gl_buffer_bind(buff), offset, size, access);
+  }
+
+  VGFX_ASSERT(ptr, "Failed to map buffer range.");
+
+  return ptr;
+}
+
+void 
+vgfx_gl_buffer_flush_range(VGFX_GL_Buffer *buff, usize offset, usize size) {
+
+  VGFX_ASSERT_NON_NULL(buff);
+
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.flush_mapped_named_buffer_range(buff->handle, offset, size);
+    return;
+  }
+
+  u32 target = _vgfx_gl_buffer_bind(buff);
+  glFlushMappedBufferRange(target, offset, size);
+}
+
+void 
+vgfx_gl_buffer_unmap(VGFX_GL_Buffer *buff) {
+
+  VGFX_ASSERT_NON_NULL(buff);
+
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.unmap_named_buffer(buff->handle);
+    return;
+  }
+
+  u32 target = _vgfx_gl_buffer_bind(buff);
+  glUnmapBuffer(target);
+}
+
+u32 
+_vgfx_gl_buffer_bind(VGFX_GL_Buffer *buff) {
+
+  // Editing an index buffer through its own target would rebind the current vertex array's
+  u32 target = (buff->type == GL_ELEMENT_ARRAY_BUFFER) ? GL_COPY_WRITE_BUFFER : buff->type;
+
+  vgfx_gl_bind_buffer(target, buff->handle);
+
+  return target;
 }
 
 VGFX_GL_VertexArray 
 vgfx_gl_vertex_array_create() {
   
   VGFX_GL_VertexArray va;
-  glGenVertexArrays(1, &va.handle);
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.create_vertex_arrays(1, &va.handle);
+  } else {
+    glGenVertexArrays(1, &va.handle);
+  }
 
-  va._cached_id = 0;
+  va._cached_id      = 0;
+  va._cached_binding = 0;
 
   return va;
 }
@@ -72,6 +596,10 @@ vgfx_gl_vertex_array_delete(VGFX_GL_VertexArray *va) {
   
   VGFX_ASSERT_NON_NULL(va);
 
+  if (s_gl_state.vertex_array == va->handle) {
+    s_gl_state.vertex_array = VGFX_GL_INVALID_HANDLE;
+  }
+
   glDeleteVertexArrays(1, &va->handle);
 
   va->handle = VGFX_GL_INVALID_HANDLE;
@@ -84,10 +612,10 @@ vgfx_gl_vertex_array_layout(VGFX_GL_VertexArray *va, VGFX_GL_VertexAttribLayout*
   VGFX_ASSERT_NON_NULL(layout);
   VGFX_ASSERT(layout->buffer.handle, "Buffer handle is invalid.");
 
-  // Calculate stride
+  // Resolve attribute offsets, each attribute is aligned to its format size
+  usize offsets[VGFX_GL_MAX_ATTRIBUTES];
   usize stride = 0;
-  usize format = 0;
-  usize tsize  = 0;
+  usize align  = 4;
 
   for (usize i = 0; i < VGFX_GL_MAX_ATTRIBUTES; ++i) {
     VGFX_GL_VertexAttrib *attrib = &layout->attribs[i];
@@ -96,24 +624,45 @@ vgfx_gl_vertex_array_layout(VGFX_GL_VertexArray *va, VGFX_GL_VertexAttribLayout*
       continue;
     }
 
-    if (!tsize) {
-      tsize = _vgfx_gl_get_format_size(attrib->format);
-      format = attrib->format;
+    VGFX_ASSERT(!(attrib->integer && attrib->norm), 
+                "Integer attributes can't be normalized.");
+    VGFX_ASSERT(!attrib->integer || _vgfx_gl_is_integer_format(attrib->format), 
+                "Integer attribute has a non-integer format, `%u`.", attrib->format);
+
+    usize tsize = _vgfx_gl_get_format_size(attrib->format);
+
+    offsets[i] = (attrib->offset) ? attrib->offset : VGFX_GL_ALIGN(stride, tsize);
+    
+    VGFX_ASSERT(offsets[i] % tsize == 0, 
+                "Attribute offset `%lu` is not aligned to `%lu`.", offsets[i], tsize);
+
+    if (offsets[i] + tsize * attrib->size > stride) {
+      stride = offsets[i] + tsize * attrib->size;
+    }
+
+    if (tsize > align) {
+      align = tsize;
     }
+  }
 
-    VGFX_ASSERT(format == attrib->format, 
-                "Format missmatch in VertexLayout, "
-                "expected `%lu`, but found `%u`.", 
-                format, attrib->format);
+  if (layout->stride) {
+    VGFX_ASSERT(layout->stride >= stride, 
+                "Layout stride `%lu` is smaller than its attributes, `%lu`.", 
+                layout->stride, stride);
 
-    stride += tsize * attrib->size;
+    stride = layout->stride;
+  } else {
+    stride = VGFX_GL_ALIGN(stride, align);
   }
 
-  // Set vertex attributes
-  glBindVertexArray(va->handle);
-  glBindBuffer(layout->buffer.type, layout->buffer.handle);
+  if (s_gl_caps.direct_state_access) {
+    _vgfx_gl_vertex_array_layout_dsa(va, layout, offsets, stride);
+    return;
+  }
 
-  usize offset = 0;
+  // Set vertex attributes
+  vgfx_gl_bind_vertex_array(va->handle);
+  vgfx_gl_bind_buffer(layout->buffer.type, layout->buffer.handle);
 
   for (usize i = 0; i < VGFX_GL_MAX_ATTRIBUTES; ++i) {
     VGFX_GL_VertexAttrib *attrib = &layout->attribs[i];
@@ -127,18 +676,53 @@ vgfx_gl_vertex_array_layout(VGFX_GL_VertexArray *va, VGFX_GL_VertexAttribLayout*
         "Vertex Buffer has already bound maximum number of attributes.");
 
     // Set GL vertex attrib pointer
-    glVertexAttribPointer(va->_cached_id, attrib->size, attrib->format, 
-                          attrib->norm, stride, (void *)offset);
+    if (attrib->integer) {
+      glVertexAttribIPointer(va->_cached_id, attrib->size, attrib->format, 
+                             stride, (void *)offsets[i]);
+    } else {
+      glVertexAttribPointer(va->_cached_id, attrib->size, attrib->format, 
+                            attrib->norm, stride, (void *)offsets[i]);
+    }
     glEnableVertexAttribArray(va->_cached_id);
     glVertexAttribDivisor(va->_cached_id, layout->update_freq);
 
     va->_cached_id += 1;
-
-    offset += tsize * attrib->size;
   }
+}
+
+void 
+_vgfx_gl_vertex_array_layout_dsa(VGFX_GL_VertexArray *va, VGFX_GL_VertexAttribLayout *layout, 
+                                 const usize *offsets, usize stride) {
+
+  // Every layout gets its own buffer binding point
+  const u32 binding = va->_cached_binding++;
+
+  s_gl_dsa.vertex_array_vertex_buffer(va->handle, binding, layout->buffer.handle, 0, stride);
+  s_gl_dsa.vertex_array_binding_divisor(va->handle, binding, layout->update_freq);
+
+  for (usize i = 0; i < VGFX_GL_MAX_ATTRIBUTES; ++i) {
+    VGFX_GL_VertexAttrib *attrib = &layout->attribs[i];
+
+    if (!attrib->size) {
+      continue;
+    }
 
-  glBindVertexArray(VGFX_GL_INVALID_HANDLE);
-  glBindBuffer(layout->buffer.type, VGFX_GL_INVALID_HANDLE);
+    VGFX_ASSERT(
+        va->_cached_id < VGFX_GL_MAX_ATTRIBUTES, 
+        "Vertex Buffer has already bound maximum number of attributes.");
+
+    if (attrib->integer) {
+      s_gl_dsa.vertex_array_attrib_i_format(
+        va->handle, va->_cached_id, attrib->size, attrib->format, offsets[i]);
+    } else {
+      s_gl_dsa.vertex_array_attrib_format(
+        va->handle, va->_cached_id, attrib->size, attrib->format, attrib->norm, offsets[i]);
+    }
+    s_gl_dsa.vertex_array_attrib_binding(va->handle, va->_cached_id, binding);
+    s_gl_dsa.enable_vertex_array_attrib(va->handle, va->_cached_id);
+
+    va->_cached_id += 1;
+  }
 }
 
 void 
@@ -152,11 +736,13 @@ vgfx_gl_vertex_array_index_buffer(VGFX_GL_VertexArray *va, VGFX_GL_Buffer *buff)
               "but found `%u`.", 
               GL_ELEMENT_ARRAY_BUFFER, buff->type);
 
-  glBindVertexArray(va->handle);
-  glBindBuffer(buff->type, buff->handle);
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.vertex_array_element_buffer(va->handle, buff->handle);
+    return;
+  }
 
-  glBindVertexArray(VGFX_GL_INVALID_HANDLE);
-  glBindBuffer(buff->type, VGFX_GL_INVALID_HANDLE);
+  vgfx_gl_bind_vertex_array(va->handle);
+  glBindBuffer(buff->type, buff->handle);
 }
 
 void 
@@ -164,7 +750,8 @@ vgfx_gl_vertex_array_reset(VGFX_GL_VertexArray *va) {
 
   VGFX_ASSERT_NON_NULL(va);
 
-  va->_cached_id = 0;
+  va->_cached_id      = 0;
+  va->_cached_binding = 0;
 }
 
 usize 
@@ -193,6 +780,304 @@ _vgfx_gl_get_format_size(u32 format) {
   VGFX_ABORT("Unsupported or unknown GL format, `%u`.", format);
 }
 
+bool 
+_vgfx_gl_is_integer_format(u32 format) {
+  switch (format) {
+  case GL_BYTE:
+  case GL_UNSIGNED_BYTE:
+  case GL_SHORT:
+  case GL_UNSIGNED_SHORT:
+  case GL_INT:
+  case GL_UNSIGNED_INT:
+    return true;
+  }
+
+  return false;
+}
+
+// =============================================
+//
+//
+// Textures
+//
+//
+// =============================================
+
+u32 
+vgfx_gl_texture_create(const VGFX_GL_TextureDesc *desc) {
+
+  VGFX_ASSERT_NON_NULL(desc);
+  VGFX_ASSERT(desc->target == GL_TEXTURE_2D || desc->target == GL_TEXTURE_2D_ARRAY, 
+              "Unsupported texture target, `%u`.", desc->target);
+
+  const i32 levels = (desc->mipmaps) ? _vgfx_gl_texture_levels(desc->width, desc->height) : 1;
+
+  u32 handle;
+
+  // Immutable storage, every level is allocated up front
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.create_textures(desc->target, 1, &handle);
+
+    s_gl_dsa.texture_parameteri(handle, GL_TEXTURE_WRAP_S, (i32)desc->wrap);
+    s_gl_dsa.texture_parameteri(handle, GL_TEXTURE_WRAP_T, (i32)desc->wrap);
+    s_gl_dsa.texture_parameteri(handle, GL_TEXTURE_MIN_FILTER, (i32)desc->min_filter);
+    s_gl_dsa.texture_parameteri(handle, GL_TEXTURE_MAG_FILTER, (i32)desc->mag_filter);
+
+    if (desc->target == GL_TEXTURE_2D_ARRAY) {
+      s_gl_dsa.texture_storage_3d(
+        handle, levels, desc->format, desc->width, desc->height, desc->layers);
+    } else {
+      s_gl_dsa.texture_storage_2d(handle, levels, desc->format, desc->width, desc->height);
+    }
+
+    return handle;
+  }
+
+  glGenTextures(1, &handle);
+  vgfx_gl_bind_texture(desc->target, handle, 0);
+
+  glTexParameteri(desc->target, GL_TEXTURE_WRAP_S, (i32)desc->wrap);
+  glTexParameteri(desc->target, GL_TEXTURE_WRAP_T, (i32)desc->wrap);
+  glTexParameteri(desc->target, GL_TEXTURE_MIN_FILTER, (i32)desc->min_filter);
+  glTexParameteri(desc->target, GL_TEXTURE_MAG_FILTER, (i32)desc->mag_filter);
+  glTexParameteri(desc->target, GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+  // Mutable fallback, the remaining levels come from mipmap generation
+  const u32 base = _vgfx_gl_texture_base_format(desc->format);
+
+  if (desc->target == GL_TEXTURE_2D_ARRAY) {
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, (i32)desc->format, desc->width, desc->height, 
+                 desc->layers, 0, base, GL_UNSIGNED_BYTE, NULL);
+  } else {
+    glTexImage2D(GL_TEXTURE_2D, 0, (i32)desc->format, desc->width, desc->height, 0, 
+                 base, GL_UNSIGNED_BYTE, NULL);
+  }
+
+  return handle;
+}
+
+void 
+vgfx_gl_texture_sub_image(u32 target, u32 handle, i32 x, i32 y, i32 layer, i32 w, i32 h, 
+                          u32 format, const void *data) {
+
+  if (s_gl_caps.direct_state_access) {
+    if (target == GL_TEXTURE_2D_ARRAY) {
+      s_gl_dsa.texture_sub_image_3d(
+        handle, 0, x, y, layer, w, h, 1, format, GL_UNSIGNED_BYTE, data);
+    } else {
+      s_gl_dsa.texture_sub_image_2d(handle, 0, x, y, w, h, format, GL_UNSIGNED_BYTE, data);
+    }
+
+    return;
+  }
+
+  vgfx_gl_bind_texture(target, handle, 0);
+
+  if (target == GL_TEXTURE_2D_ARRAY) {
+    glTexSubImage3D(target, 0, x, y, layer, w, h, 1, format, GL_UNSIGNED_BYTE, data);
+  } else {
+    glTexSubImage2D(target, 0, x, y, w, h, format, GL_UNSIGNED_BYTE, data);
+  }
+}
+
+void 
+vgfx_gl_texture_level_image(u32 handle, i32 level, i32 w, i32 h, u32 format, const void *data) {
+
+  // Whole level of a 2D texture in a sized format, used for prebaked mip chains
+  const u32 base = _vgfx_gl_texture_base_format(format);
+
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.texture_sub_image_2d(handle, level, 0, 0, w, h, base, GL_UNSIGNED_BYTE, data);
+    return;
+  }
+
+  // Mutable storage only allocated the base level, the others are specified here
+  vgfx_gl_bind_texture(GL_TEXTURE_2D, handle, 0);
+  glTexImage2D(GL_TEXTURE_2D, level, (i32)format, w, h, 0, base, GL_UNSIGNED_BYTE, data);
+}
+
+void 
+vgfx_gl_texture_generate_mipmap(u32 target, u32 handle) {
+
+  if (s_gl_caps.direct_state_access) {
+    s_gl_dsa.generate_texture_mipmap(handle);
+    return;
+  }
+
+  vgfx_gl_bind_texture(target, handle, 0);
+  glGenerateMipmap(target);
+}
+
+i32 
+_vgfx_gl_texture_levels(i32 width, i32 height) {
+
+  i32 levels = 1;
+  for (i32 size = (width > height) ? width : height; size > 1; size >>= 1) {
+    levels += 1;
+  }
+
+  return levels;
+}
+
+u32 
+_vgfx_gl_texture_base_format(u32 format) {
+
+  switch (format) {
+  case GL_R8:
+    return GL_RED;
+  case GL_RG8:
+    return GL_RG;
+  case GL_RGB8:
+    return GL_RGB;
+  case GL_RGBA8:
+    return GL_RGBA;
+  default:
+    VGFX_ABORT("Unsupported texture format, `%u`.", format);
+    return GL_RGBA;
+  }
+}
+
+// =============================================
+//
+//
+// Sync
+//
+//
+// =============================================
+
+VGFX_GL_Fence 
+vgfx_gl_fence_create() {
+
+  return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void 
+vgfx_gl_fence_delete(VGFX_GL_Fence *fence) {
+
+  VGFX_ASSERT_NON_NULL(fence);
+
+  glDeleteSync(*fence);
+
+  *fence = NULL;
+}
+
+bool 
+vgfx_gl_fence_wait(VGFX_GL_Fence *fence) {
+
+  VGFX_ASSERT_NON_NULL(fence);
+
+  // Check without blocking first
+  u32 status = glClientWaitSync(*fence, 0, 0);
+  if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+    return false;
+  }
+
+  do {
+    status = glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT, 
+                              VGFX_GL_FENCE_TIMEOUT);
+
+    VGFX_ASSERT(status != GL_WAIT_FAILED, "Failed to wait for fence.");
+  } while (status == GL_TIMEOUT_EXPIRED);
+
+  return true;
+}
+
+bool 
+vgfx_gl_fence_signaled(VGFX_GL_Fence *fence) {
+
+  VGFX_ASSERT_NON_NULL(fence);
+
+  u32 status = glClientWaitSync(*fence, 0, 0);
+
+  return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+// =============================================
+//
+//
+// Queries
+//
+//
+// =============================================
+
+VGFX_GL_Query 
+vgfx_gl_query_create() {
+
+  VGFX_GL_Query query;
+  glGenQueries(1, &query);
+
+  return query;
+}
+
+void 
+vgfx_gl_query_delete(VGFX_GL_Query *query) {
+
+  VGFX_ASSERT_NON_NULL(query);
+
+  glDeleteQueries(1, query);
+
+  *query = VGFX_GL_INVALID_HANDLE;
+}
+
+void 
+vgfx_gl_query_begin(VGFX_GL_Query *query, u32 target) {
+
+  VGFX_ASSERT_NON_NULL(query);
+  VGFX_DEBUG_ASSERT(
+    target == GL_TIME_ELAPSED || s_gl_caps.pipeline_statistics, 
+    "Pipeline statistics queries are not supported.");
+
+  glBeginQuery(target, *query);
+}
+
+void 
+vgfx_gl_query_end(u32 target) {
+
+  glEndQuery(target);
+}
+
+bool 
+vgfx_gl_query_available(VGFX_GL_Query *query) {
+
+  VGFX_ASSERT_NON_NULL(query);
+
+  u32 available = GL_FALSE;
+  glGetQueryObjectuiv(*query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+  return available == GL_TRUE;
+}
+
+u64 
+vgfx_gl_query_result(VGFX_GL_Query *query) {
+
+  VGFX_ASSERT_NON_NULL(query);
+
+  u64 result = 0;
+  glGetQueryObjectui64v(*query, GL_QUERY_RESULT, &result);
+
+  return result;
+}
+
+// =============================================
+//
+//
+// Draw
+//
+//
+// =============================================
+
+void 
+vgfx_gl_multi_draw_elements_indirect(VGFX_GL_Buffer *buff, u32 mode, u32 type, 
+                                     usize count) {
+
+  VGFX_ASSERT_NON_NULL(buff);
+  VGFX_ASSERT(s_gl_caps.multi_draw_indirect, "Multi-draw indirect is not supported.");
+  VGFX_DEBUG_ASSERT(buff->type == GL_DRAW_INDIRECT_BUFFER, "Invalid buffer type.");
+
+  vgfx_gl_bind_buffer(GL_DRAW_INDIRECT_BUFFER, buff->handle);
+  s_gl_multi_draw_elements_indirect(mode, type, NULL, count, 0);
+}
+
 // =============================================
 //
 //
@@ -206,15 +1091,13 @@ vgfx_gl_bind_texture_handle(VGFX_AS_TextureHandle handle, u32 slot) {
   
   VGFX_ASSERT(handle, "Invalid handle.");
 
-  glActiveTexture(GL_TEXTURE0 + slot);
-  glBindTexture(GL_TEXTURE_2D, handle);
+  vgfx_gl_bind_texture(GL_TEXTURE_2D, handle, slot);
 }
 
 void 
 vgfx_gl_unbind_texture_handle(u32 slot) {
 
-  glActiveTexture(GL_TEXTURE0 + slot);
-  glBindTexture(GL_TEXTURE_2D, VGFX_GL_INVALID_HANDLE);
+  vgfx_gl_bind_texture(GL_TEXTURE_2D, VGFX_GL_INVALID_HANDLE, slot);
 }
 
 void 
@@ -224,15 +1107,18 @@ vgfx_gl_bind_shader_program(VGFX_AS_ShaderProgramHandle handle) {
 
   s_gl_bound_shader = handle;
 
+  if (_vgfx_gl_state_elide(&s_gl_state.program, handle)) {
+    return;
+  }
+
   glUseProgram(handle);
 }
 
 void 
 vgfx_gl_unbind_shader_program() {
 
+  // The program stays current in GL, so binding it again next pass is free
   s_gl_bound_shader = VGFX_GL_INVALID_HANDLE;
-
-  glUseProgram(VGFX_GL_INVALID_HANDLE);
 }
 
 // =============================================
@@ -250,23 +1136,25 @@ vgfx_gl_uniform_fv(const char *name, usize count, const f32 *v) {
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  switch (count) {
-  case 1:
-    glUniform1fv(location, count, v);
-    break;
-  case 2:
-    glUniform2fv(location, count, v);
-    break;
-  case 3:
-    glUniform3fv(location, count, v);
-    break;
-  case 4:
-    glUniform4fv(location, count, v);
-    break;
-  default:
-    VGFX_ABORT("Unsupported uniform count, `%lu`.", count);
-    break;
-  }
+  do {
+    switch (count) {
+    case 1:
+      glUniform1fv(location, count, v);
+      break;
+    case 2:
+      glUniform2fv(location, count, v);
+      break;
+    case 3:
+      glUniform3fv(location, count, v);
+      break;
+    case 4:
+      glUniform4fv(location, count, v);
+      break;
+    default:
+      VGFX_ABORT("Unsupported uniform count, `%lu`.", count);
+      break;
+    }
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -276,23 +1164,25 @@ vgfx_gl_uniform_iv(const char* name, usize count, const i32 *v) {
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  switch (count) {
-  case 1:
-    glUniform1iv(location, count, v);
-    break;
-  case 2:
-    glUniform2iv(location, count, v);
-    break;
-  case 3:
-    glUniform3iv(location, count, v);
-    break;
-  case 4:
-    glUniform4iv(location, count, v);
-    break;
-  default:
-    VGFX_ABORT("Unsupported uniform count, `%lu`.", count);
-    break;
-  }
+  do {
+    switch (count) {
+    case 1:
+      glUniform1iv(location, count, v);
+      break;
+    case 2:
+      glUniform2iv(location, count, v);
+      break;
+    case 3:
+      glUniform3iv(location, count, v);
+      break;
+    case 4:
+      glUniform4iv(location, count, v);
+      break;
+    default:
+      VGFX_ABORT("Unsupported uniform count, `%lu`.", count);
+      break;
+    }
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -302,23 +1192,25 @@ vgfx_gl_uniform_uv(const char* name, usize count, const u32 *v) {
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  switch (count) {
-  case 1:
-    glUniform1uiv(location, count, v);
-    break;
-  case 2:
-    glUniform2uiv(location, count, v);
-    break;
-  case 3:
-    glUniform3uiv(location, count, v);
-    break;
-  case 4:
-    glUniform4uiv(location, count, v);
-    break;
-  default:
-    VGFX_ABORT("Unsupported uniform count, `%lu`.", count);
-    break;
-  }
+  do {
+    switch (count) {
+    case 1:
+      glUniform1uiv(location, count, v);
+      break;
+    case 2:
+      glUniform2uiv(location, count, v);
+      break;
+    case 3:
+      glUniform3uiv(location, count, v);
+      break;
+    case 4:
+      glUniform4uiv(location, count, v);
+      break;
+    default:
+      VGFX_ABORT("Unsupported uniform count, `%lu`.", count);
+      break;
+    }
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -328,7 +1220,9 @@ vgfx_gl_uniform_mat2fv(const char *name, usize count, bool trans, const f32 *v)
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  glUniformMatrix2fv(location, count, trans, v);
+  do {
+    glUniformMatrix2fv(location, count, trans, v);
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -338,7 +1232,9 @@ vgfx_gl_uniform_mat3fv(const char *name, usize count, bool trans, const f32 *v)
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  glUniformMatrix3fv(location, count, trans, v);
+  do {
+    glUniformMatrix3fv(location, count, trans, v);
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -348,7 +1244,9 @@ vgfx_gl_uniform_mat4fv(const char *name, usize count, bool trans, const f32 *v)
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  glUniformMatrix4fv(location, count, trans, v);
+  do {
+    glUniformMatrix4fv(location, count, trans, v);
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -358,7 +1256,9 @@ vgfx_gl_uniform_mat2x3fv(const char *name, usize count, bool trans, const f32 *v
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  glUniformMatrix2x3fv(location, count, trans, v);
+  do {
+    glUniformMatrix2x3fv(location, count, trans, v);
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -368,7 +1268,9 @@ vgfx_gl_uniform_mat3x2fv(const char *name, usize count, bool trans, const f32 *v
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  glUniformMatrix3x2fv(location, count, trans, v);
+  do {
+    glUniformMatrix3x2fv(location, count, trans, v);
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -378,7 +1280,9 @@ vgfx_gl_uniform_mat2x4fv(const char *name, usize count, bool trans, const f32 *v
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  glUniformMatrix2x4fv(location, count, trans, v);
+  do {
+    glUniformMatrix2x4fv(location, count, trans, v);
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -388,7 +1292,9 @@ vgfx_gl_uniform_mat4x2fv(const char *name, usize count, bool trans, const f32 *v
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  glUniformMatrix4x2fv(location, count, trans, v);
+  do {
+    glUniformMatrix4x2fv(location, count, trans, v);
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -398,7 +1304,9 @@ vgfx_gl_uniform_mat3x4fv(const char *name, usize count, bool trans, const f32 *v
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  glUniformMatrix3x4fv(location, count, trans, v);
+  do {
+    glUniformMatrix3x4fv(location, count, trans, v);
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
 void 
@@ -408,6 +1316,376 @@ vgfx_gl_uniform_mat4x3fv(const char *name, usize count, bool trans, const f32 *v
 
   VGFX_GL_DEBUG_UNIFORM_WARNING(location, name);
 
-  glUniformMatrix4x3fv(location, count, trans, v);
+  do {
+    glUniformMatrix4x3fv(location, count, trans, v);
+  } while (_vgfx_gl_uniform_mirror_next(&location));
 }
 
+void
+vgfx_gl_uniform_set_fv(const VGFX_AS_Uniform *uniform, usize count, const f32 *v) {
+
+  // Inactive uniforms resolve to NULL, like a location of -1
+  if (!uniform) {
+    return;
+  }
+
+  VGFX_DEBUG_ASSERT(s_gl_bound_shader, "Shader program isn't bound.");
+
+  i32 location = uniform->location;
+
+  do {
+    switch (uniform->type) {
+    case GL_FLOAT:
+      glUniform1fv(location, count, v);
+      break;
+    case GL_FLOAT_VEC2:
+      glUniform2fv(location, count, v);
+      break;
+    case GL_FLOAT_VEC3:
+      glUniform3fv(location, count, v);
+      break;
+    case GL_FLOAT_VEC4:
+      glUniform4fv(location, count, v);
+      break;
+    default:
+      VGFX_DEBUG_WARN("Uniform isn't a float vector, `%s`.\n", uniform->name);
+      break;
+    }
+  } while (_vgfx_gl_uniform_mirror_next(&location));
+}
+
+void
+vgfx_gl_uniform_set_iv(const VGFX_AS_Uniform *uniform, usize count, const i32 *v) {
+
+  if (!uniform) {
+    return;
+  }
+
+  VGFX_DEBUG_ASSERT(s_gl_bound_shader, "Shader program isn't bound.");
+
+  i32 location = uniform->location;
+
+  do {
+    switch (uniform->type) {
+    case GL_INT:
+    case GL_BOOL:
+      glUniform1iv(location, count, v);
+      break;
+    case GL_INT_VEC2:
+    case GL_BOOL_VEC2:
+      glUniform2iv(location, count, v);
+      break;
+    case GL_INT_VEC3:
+    case GL_BOOL_VEC3:
+      glUniform3iv(location, count, v);
+      break;
+    case GL_INT_VEC4:
+    case GL_BOOL_VEC4:
+      glUniform4iv(location, count, v);
+      break;
+    default:
+      if (_vgfx_as_uniform_sampler(uniform->type)) {
+        glUniform1iv(location, count, v);
+        break;
+      }
+
+      VGFX_DEBUG_WARN("Uniform isn't an int vector, `%s`.\n", uniform->name);
+      break;
+    }
+  } while (_vgfx_gl_uniform_mirror_next(&location));
+}
+
+void
+vgfx_gl_uniform_set_uv(const VGFX_AS_Uniform *uniform, usize count, const u32 *v) {
+
+  if (!uniform) {
+    return;
+  }
+
+  VGFX_DEBUG_ASSERT(s_gl_bound_shader, "Shader program isn't bound.");
+
+  i32 location = uniform->location;
+
+  do {
+    switch (uniform->type) {
+    case GL_UNSIGNED_INT:
+      glUniform1uiv(location, count, v);
+      break;
+    case GL_UNSIGNED_INT_VEC2:
+      glUniform2uiv(location, count, v);
+      break;
+    case GL_UNSIGNED_INT_VEC3:
+      glUniform3uiv(location, count, v);
+      break;
+    case GL_UNSIGNED_INT_VEC4:
+      glUniform4uiv(location, count, v);
+      break;
+    default:
+      VGFX_DEBUG_WARN("Uniform isn't an unsigned vector, `%s`.\n", uniform->name);
+      break;
+    }
+  } while (_vgfx_gl_uniform_mirror_next(&location));
+}
+
+void
+vgfx_gl_uniform_set_matfv(const VGFX_AS_Uniform *uniform, usize count, bool trans, 
+                          const f32 *v) {
+
+  if (!uniform) {
+    return;
+  }
+
+  VGFX_DEBUG_ASSERT(s_gl_bound_shader, "Shader program isn't bound.");
+
+  i32 location = uniform->location;
+
+  do {
+    switch (uniform->type) {
+    case GL_FLOAT_MAT2:
+      glUniformMatrix2fv(location, count, trans, v);
+      break;
+    case GL_FLOAT_MAT3:
+      glUniformMatrix3fv(location, count, trans, v);
+      break;
+    case GL_FLOAT_MAT4:
+      glUniformMatrix4fv(location, count, trans, v);
+      break;
+    case GL_FLOAT_MAT2x3:
+      glUniformMatrix2x3fv(location, count, trans, v);
+      break;
+    case GL_FLOAT_MAT3x2:
+      glUniformMatrix3x2fv(location, count, trans, v);
+      break;
+    case GL_FLOAT_MAT2x4:
+      glUniformMatrix2x4fv(location, count, trans, v);
+      break;
+    case GL_FLOAT_MAT4x2:
+      glUniformMatrix4x2fv(location, count, trans, v);
+      break;
+    case GL_FLOAT_MAT3x4:
+      glUniformMatrix3x4fv(location, count, trans, v);
+      break;
+    case GL_FLOAT_MAT4x3:
+      glUniformMatrix4x3fv(location, count, trans, v);
+      break;
+    default:
+      VGFX_DEBUG_WARN("Uniform isn't a matrix, `%s`.\n", uniform->name);
+      break;
+    }
+  } while (_vgfx_gl_uniform_mirror_next(&location));
+}
+
+usize
+vgfx_gl_uniform_link(VGFX_AS_ShaderProgramHandle src, VGFX_AS_ShaderProgramHandle dst, 
+                     VGFX_GL_UniformLink **links) {
+
+  VGFX_ASSERT(src && dst, "Invalid handle.");
+  VGFX_ASSERT_NON_NULL(links);
+
+  i32 count;
+  glGetProgramiv(src, GL_ACTIVE_UNIFORMS, &count);
+
+  usize len = 0;
+  usize cap = 0;
+
+  for (i32 i = 0; i < count; ++i) {
+    char name[VGFX_AS_MAX_UNIFORM_NAME];
+    i32  size;
+    u32  type;
+    glGetActiveUniform(src, (u32)i, sizeof(name), NULL, &size, &type, name);
+
+    // Samplers are assigned when the program is loaded
+    if (_vgfx_as_uniform_sampler(type)) {
+      continue;
+    }
+
+    // Arrays are reported by their first element
+    char *bracket = strchr(name, '[');
+    if (bracket) {
+      *bracket = '\0';
+    }
+
+    for (i32 e = 0; e < size; ++e) {
+      char element[VGFX_AS_MAX_UNIFORM_NAME + 16];
+      if (bracket) {
+        snprintf(element, sizeof(element), "%s[%d]", name, e);
+      } else {
+        snprintf(element, sizeof(element), "%s", name);
+      }
+
+      // Block members and unused uniforms have no location
+      i32 src_loc = glGetUniformLocation(src, element);
+      i32 dst_loc = glGetUniformLocation(dst, element);
+
+      if (src_loc < 0 || dst_loc < 0) {
+        continue;
+      }
+
+      if (len == cap) {
+        cap    = (cap) ? cap * 2 : 16;
+        *links = (VGFX_GL_UniformLink *)realloc(*links, cap * sizeof(VGFX_GL_UniformLink));
+
+        VGFX_ASSERT(*links, "Failed to allocate uniform links.");
+      }
+
+      (*links)[len++] = (VGFX_GL_UniformLink){src_loc, dst_loc, type};
+    }
+  }
+
+  return len;
+}
+
+void
+vgfx_gl_uniform_mirror(VGFX_AS_ShaderProgramHandle src, VGFX_AS_ShaderProgramHandle dst, 
+                       const VGFX_GL_UniformLink *links, usize count) {
+
+  if (s_gl_mirror.src == src && s_gl_mirror.dst == dst) {
+    return;
+  }
+
+  if (count > s_gl_mirror.capacity) {
+    s_gl_mirror.links    = (VGFX_GL_UniformLink *)realloc(
+      s_gl_mirror.links, count * sizeof(VGFX_GL_UniformLink));
+    s_gl_mirror.capacity = count;
+
+    VGFX_ASSERT(s_gl_mirror.links, "Failed to allocate uniform mirror.");
+  }
+
+  if (count) {
+    memcpy(s_gl_mirror.links, links, count * sizeof(VGFX_GL_UniformLink));
+  }
+
+  s_gl_mirror.src   = src;
+  s_gl_mirror.dst   = dst;
+  s_gl_mirror.count = (src && dst) ? count : 0;
+
+  if (!s_gl_mirror.count) {
+    return;
+  }
+
+  // Values written before the pair was mirrored are read back once
+  glUseProgram(dst);
+  vgfx_gl_uniform_copy(src, s_gl_mirror.links, s_gl_mirror.count);
+  glUseProgram(s_gl_bound_shader);
+
+  s_gl_state.program = s_gl_bound_shader;
+}
+
+bool
+_vgfx_gl_uniform_mirror_next(i32 *location) {
+
+  // Second pass of a mirrored write, the bound program is restored
+  if (s_gl_mirror.active) {
+    s_gl_mirror.active = false;
+    glUseProgram(s_gl_mirror.src);
+    return false;
+  }
+
+  if (!s_gl_mirror.count || s_gl_bound_shader != s_gl_mirror.src || *location < 0) {
+    return false;
+  }
+
+  for (usize i = 0; i < s_gl_mirror.count; ++i) {
+    if (s_gl_mirror.links[i].src == *location) {
+      *location          = s_gl_mirror.links[i].dst;
+      s_gl_mirror.active = true;
+      glUseProgram(s_gl_mirror.dst);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void
+vgfx_gl_uniform_copy(VGFX_AS_ShaderProgramHandle src, const VGFX_GL_UniformLink *links, 
+                     usize count) {
+
+  VGFX_ASSERT(src, "Invalid handle.");
+
+  for (usize i = 0; i < count; ++i) {
+    _vgfx_gl_uniform_copy_value(src, links[i].src, links[i].dst, links[i].type);
+  }
+}
+
+void
+_vgfx_gl_uniform_copy_value(VGFX_AS_ShaderProgramHandle src, i32 src_loc, i32 dst_loc, 
+                            u32 type) {
+
+  f32 f[16];
+  i32 i[4];
+  u32 u[4];
+
+  switch (type) {
+  case GL_FLOAT:
+    glGetUniformfv(src, src_loc, f);
+    glUniform1fv(dst_loc, 1, f);
+    break;
+  case GL_FLOAT_VEC2:
+    glGetUniformfv(src, src_loc, f);
+    glUniform2fv(dst_loc, 1, f);
+    break;
+  case GL_FLOAT_VEC3:
+    glGetUniformfv(src, src_loc, f);
+    glUniform3fv(dst_loc, 1, f);
+    break;
+  case GL_FLOAT_VEC4:
+    glGetUniformfv(src, src_loc, f);
+    glUniform4fv(dst_loc, 1, f);
+    break;
+  case GL_FLOAT_MAT2:
+    glGetUniformfv(src, src_loc, f);
+    glUniformMatrix2fv(dst_loc, 1, GL_FALSE, f);
+    break;
+  case GL_FLOAT_MAT3:
+    glGetUniformfv(src, src_loc, f);
+    glUniformMatrix3fv(dst_loc, 1, GL_FALSE, f);
+    break;
+  case GL_FLOAT_MAT4:
+    glGetUniformfv(src, src_loc, f);
+    glUniformMatrix4fv(dst_loc, 1, GL_FALSE, f);
+    break;
+  case GL_INT:
+  case GL_BOOL:
+    glGetUniformiv(src, src_loc, i);
+    glUniform1iv(dst_loc, 1, i);
+    break;
+  case GL_INT_VEC2:
+  case GL_BOOL_VEC2:
+    glGetUniformiv(src, src_loc, i);
+    glUniform2iv(dst_loc, 1, i);
+    break;
+  case GL_INT_VEC3:
+  case GL_BOOL_VEC3:
+    glGetUniformiv(src, src_loc, i);
+    glUniform3iv(dst_loc, 1, i);
+    break;
+  case GL_INT_VEC4:
+  case GL_BOOL_VEC4:
+    glGetUniformiv(src, src_loc, i);
+    glUniform4iv(dst_loc, 1, i);
+    break;
+  case GL_UNSIGNED_INT:
+    glGetUniformuiv(src, src_loc, u);
+    glUniform1uiv(dst_loc, 1, u);
+    break;
+  case GL_UNSIGNED_INT_VEC2:
+    glGetUniformuiv(src, src_loc, u);
+    glUniform2uiv(dst_loc, 1, u);
+    break;
+  case GL_UNSIGNED_INT_VEC3:
+    glGetUniformuiv(src, src_loc, u);
+    glUniform3uiv(dst_loc, 1, u);
+    break;
+  case GL_UNSIGNED_INT_VEC4:
+    glGetUniformuiv(src, src_loc, u);
+    glUniform4uiv(dst_loc, 1, u);
+    break;
+  default:
+    // Samplers are assigned when the program is loaded
+    if (!_vgfx_as_uniform_sampler(type)) {
+      VGFX_DEBUG_WARN("Uniform type can't be copied, `%u`.\n", type);
+    }
+    break;
+  }
+}
@@ -3,6 +3,157 @@
 #include "core.h"
 #include "asset.h"
 
+// =============================================
+//
+//
+// Capabilities
+//
+//
+// =============================================
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+#ifndef GL_DYNAMIC_STORAGE_BIT
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#endif
+
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+#ifndef GL_VERTICES_SUBMITTED
+#define GL_VERTICES_SUBMITTED 0x82EE
+#endif
+
+#ifndef GL_PRIMITIVES_SUBMITTED
+#define GL_PRIMITIVES_SUBMITTED 0x82EF
+#endif
+
+#ifndef GL_FRAGMENT_SHADER_INVOCATIONS
+#define GL_FRAGMENT_SHADER_INVOCATIONS 0x82F4
+#endif
+
+#define VGFX_GL_VERSION(major, minor) ((major) * 10 + (minor))
+
+typedef enum VGFX_GL_Tier {
+  VGFX_GL_TIER_BASE,     // 3.3 core
+  VGFX_GL_TIER_INDIRECT, // 4.3 multi-draw indirect with gl_DrawID
+} VGFX_GL_Tier;
+
+typedef struct VGFX_GL_Caps VGFX_GL_Caps;
+struct VGFX_GL_Caps {
+  u32          version;
+  VGFX_GL_Tier tier;
+  bool         buffer_storage;
+  bool         multi_draw_indirect;
+  bool         shader_draw_parameters;
+  bool         pipeline_statistics;
+  bool         direct_state_access;
+  u32          max_texture_units;
+  u32          max_texture_size;
+  u32          max_array_layers;
+};
+
+const VGFX_GL_Caps *
+vgfx_gl_caps();
+
+void
+_vgfx_gl_load_caps();
+
+bool
+_vgfx_gl_load_dsa();
+
+bool
+_vgfx_gl_has_extension(const char *name);
+
+// =============================================
+//
+//
+// State
+//
+//
+// =============================================
+
+#define VGFX_GL_STATE_MAX_TEXTURE_UNIT 32
+#define VGFX_GL_STATE_BUFFER_COUNT     5
+#define VGFX_GL_STATE_UNKNOWN          0xFFFFFFFFu
+
+typedef struct VGFX_GL_StateStats VGFX_GL_StateStats;
+struct VGFX_GL_StateStats {
+  usize calls;  // State changes requested
+  usize elided; // Skipped because the driver already had them
+};
+
+typedef struct _VGFX_GL_State _VGFX_GL_State;
+struct _VGFX_GL_State {
+  u32                program;
+  u32                vertex_array;
+  u32                buffers[VGFX_GL_STATE_BUFFER_COUNT];
+  u32                active_unit;
+  u32                textures[VGFX_GL_STATE_MAX_TEXTURE_UNIT][2]; // 2D, 2D array
+  u32                blend;
+  u32                blend_func[2];
+  u32                depth_test;
+  u32                depth_mask;
+  i32                viewport[4];
+  VGFX_GL_StateStats crn;
+  VGFX_GL_StateStats frame;
+};
+
+void 
+vgfx_gl_bind_vertex_array(u32 handle);
+
+void 
+vgfx_gl_bind_buffer(u32 target, u32 handle);
+
+void 
+vgfx_gl_bind_texture(u32 target, u32 handle, u32 unit);
+
+void 
+vgfx_gl_set_blend(bool enable);
+
+void 
+vgfx_gl_set_blend_func(u32 src, u32 dst);
+
+void 
+vgfx_gl_set_depth_test(bool enable);
+
+void 
+vgfx_gl_set_depth_mask(bool enable);
+
+void 
+vgfx_gl_set_viewport(i32 x, i32 y, i32 w, i32 h);
+
+void 
+vgfx_gl_delete_texture(u32 handle);
+
+void 
+vgfx_gl_delete_shader_program(u32 handle);
+
+void 
+vgfx_gl_state_invalidate();
+
+void 
+vgfx_gl_state_end_frame();
+
+const VGFX_GL_StateStats *
+vgfx_gl_state_stats();
+
+i32 
+_vgfx_gl_state_buffer_slot(u32 target);
+
+i32 
+_vgfx_gl_state_texture_slot(u32 target);
+
+bool 
+_vgfx_gl_state_elide(u32 *cached, u32 value);
+
 // =============================================
 //
 //
@@ -15,6 +166,8 @@
 
 #define VGFX_GL_MAX_ATTRIBUTES 16
 
+#define VGFX_GL_ALIGN(val, align) (((val) + (align) - 1) / (align) * (align))
+
 typedef struct VGFX_GL_Buffer VGFX_GL_Buffer;
 struct VGFX_GL_Buffer {
   u32   handle;
@@ -24,15 +177,18 @@ struct VGFX_GL_Buffer {
 
 typedef struct VGFX_GL_VertexAttrib VGFX_GL_VertexAttrib;
 struct VGFX_GL_VertexAttrib {
-  u32 size;
-  u32 format;
-  u32 norm;
+  u32   size;
+  u32   format;
+  u32   norm;
+  bool  integer;
+  usize offset; // Zero packs it after the previous attribute
 };
 
 typedef struct VGFX_GL_VertexAttribLayout VGFX_GL_VertexAttribLayout;
 struct VGFX_GL_VertexAttribLayout {
   VGFX_GL_Buffer       buffer;
   VGFX_GL_VertexAttrib attribs[VGFX_GL_MAX_ATTRIBUTES];
+  usize                stride;
   usize                update_freq;
 };
 
@@ -40,6 +196,7 @@ typedef struct VGFX_GL_VertexArray VGFX_GL_VertexArray;
 struct VGFX_GL_VertexArray {
   u32 handle;
   u32 _cached_id;
+  u32 _cached_binding;
 };
 
 VGFX_GL_Buffer 
@@ -54,6 +211,21 @@ vgfx_gl_buffer_data(VGFX_GL_Buffer *buff, u32 usage, usize size, void *data);
 void 
 vgfx_gl_buffer_sub_data(VGFX_GL_Buffer *buff, usize offset, usize size, void *data);
 
+void 
+vgfx_gl_buffer_storage(VGFX_GL_Buffer *buff, usize size, void *data, u32 flags);
+
+void *
+vgfx_gl_buffer_map_range(VGFX_GL_Buffer *buff, usize offset, usize size, u32 access);
+
+void 
+vgfx_gl_buffer_flush_range(VGFX_GL_Buffer *buff, usize offset, usize size);
+
+void 
+vgfx_gl_buffer_unmap(VGFX_GL_Buffer *buff);
+
+u32 
+_vgfx_gl_buffer_bind(VGFX_GL_Buffer *buff);
+
 VGFX_GL_VertexArray 
 vgfx_gl_vertex_array_create();
 
@@ -63,6 +235,10 @@ vgfx_gl_vertex_array_delete(VGFX_GL_VertexArray *va);
 void 
 vgfx_gl_vertex_array_layout(VGFX_GL_VertexArray *va, VGFX_GL_VertexAttribLayout *layout);
 
+void 
+_vgfx_gl_vertex_array_layout_dsa(VGFX_GL_VertexArray *va, VGFX_GL_VertexAttribLayout *layout, 
+                                 const usize *offsets, usize stride);
+
 void 
 vgfx_gl_vertex_array_index_buffer(VGFX_GL_VertexArray *va, VGFX_GL_Buffer *buff);
 
@@ -72,6 +248,122 @@ vgfx_gl_vertex_array_reset(VGFX_GL_VertexArray *va);
 usize 
 _vgfx_gl_get_format_size(u32 format);
 
+bool 
+_vgfx_gl_is_integer_format(u32 format);
+
+// =============================================
+//
+//
+// Textures
+//
+//
+// =============================================
+
+typedef struct VGFX_GL_TextureDesc VGFX_GL_TextureDesc;
+struct VGFX_GL_TextureDesc {
+  u32  target;     // GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY
+  u32  format;     // Sized internal format
+  i32  width;
+  i32  height;
+  i32  layers;     // Ignored by 2D textures
+  u32  wrap;
+  u32  min_filter;
+  u32  mag_filter;
+  bool mipmaps;
+};
+
+u32 
+vgfx_gl_texture_create(const VGFX_GL_TextureDesc *desc);
+
+void 
+vgfx_gl_texture_sub_image(u32 target, u32 handle, i32 x, i32 y, i32 layer, i32 w, i32 h, 
+                          u32 format, const void *data);
+
+void 
+vgfx_gl_texture_level_image(u32 handle, i32 level, i32 w, i32 h, u32 format, const void *data);
+
+void 
+vgfx_gl_texture_generate_mipmap(u32 target, u32 handle);
+
+i32 
+_vgfx_gl_texture_levels(i32 width, i32 height);
+
+u32 
+_vgfx_gl_texture_base_format(u32 format);
+
+// =============================================
+//
+//
+// Sync
+//
+//
+// =============================================
+
+#define VGFX_GL_FENCE_TIMEOUT 1000000000
+
+typedef GLsync VGFX_GL_Fence;
+
+VGFX_GL_Fence 
+vgfx_gl_fence_create();
+
+void 
+vgfx_gl_fence_delete(VGFX_GL_Fence *fence);
+
+bool 
+vgfx_gl_fence_wait(VGFX_GL_Fence *fence);
+
+bool 
+vgfx_gl_fence_signaled(VGFX_GL_Fence *fence);
+
+// =============================================
+//
+//
+// Queries
+//
+//
+// =============================================
+
+typedef u32 VGFX_GL_Query;
+
+VGFX_GL_Query 
+vgfx_gl_query_create();
+
+void 
+vgfx_gl_query_delete(VGFX_GL_Query *query);
+
+void 
+vgfx_gl_query_begin(VGFX_GL_Query *query, u32 target);
+
+void 
+vgfx_gl_query_end(u32 target);
+
+bool 
+vgfx_gl_query_available(VGFX_GL_Query *query);
+
+u64 
+vgfx_gl_query_result(VGFX_GL_Query *query);
+
+// =============================================
+//
+//
+// Draw
+//
+//
+// =============================================
+
+typedef struct VGFX_GL_DrawElementsIndirectCommand VGFX_GL_DrawElementsIndirectCommand;
+struct VGFX_GL_DrawElementsIndirectCommand {
+  u32 count;
+  u32 instance_count;
+  u32 first_index;
+  i32 base_vertex;
+  u32 base_instance;
+};
+
+void 
+vgfx_gl_multi_draw_elements_indirect(VGFX_GL_Buffer *buff, u32 mode, u32 type, 
+                                     usize count);
+
 // =============================================
 //
 //
@@ -100,6 +392,14 @@ vgfx_gl_unbind_shader_program();
 //
 // =============================================
 
+// Same uniform in two programs, resolved once so copies skip name lookups
+typedef struct VGFX_GL_UniformLink VGFX_GL_UniformLink;
+struct VGFX_GL_UniformLink {
+  i32 src;
+  i32 dst;
+  u32 type;
+};
+
 #ifndef NDEBUG
 #define VGFX_GL_ENABLE_DEBUG_UNIFORM_WARNING 1
 #else
@@ -120,7 +420,6 @@ vgfx_gl_unbind_shader_program();
   } while (0)
 #endif
 
-
 void
 vgfx_gl_uniform_fv(const char* name, usize count, const f32 *v);
 
@@ -156,3 +455,35 @@ vgfx_gl_uniform_mat3x4fv(const char *name, usize count, bool trans, const f32 *v
 
 void
 vgfx_gl_uniform_mat4x3fv(const char *name, usize count, bool trans, const f32 *v);
+
+void
+vgfx_gl_uniform_set_fv(const VGFX_AS_Uniform *uniform, usize count, const f32 *v);
+
+void
+vgfx_gl_uniform_set_iv(const VGFX_AS_Uniform *uniform, usize count, const i32 *v);
+
+void
+vgfx_gl_uniform_set_uv(const VGFX_AS_Uniform *uniform, usize count, const u32 *v);
+
+void
+vgfx_gl_uniform_set_matfv(const VGFX_AS_Uniform *uniform, usize count, bool trans, 
+                          const f32 *v);
+
+usize
+vgfx_gl_uniform_link(VGFX_AS_ShaderProgramHandle src, VGFX_AS_ShaderProgramHandle dst, 
+                     VGFX_GL_UniformLink **links);
+
+void
+vgfx_gl_uniform_mirror(VGFX_AS_ShaderProgramHandle src, VGFX_AS_ShaderProgramHandle dst, 
+                       const VGFX_GL_UniformLink *links, usize count);
+
+bool
+_vgfx_gl_uniform_mirror_next(i32 *location);
+
+void
+vgfx_gl_uniform_copy(VGFX_AS_ShaderProgramHandle src, const VGFX_GL_UniformLink *links, 
+                     usize count);
+
+void
+_vgfx_gl_uniform_copy_value(VGFX_AS_ShaderProgramHandle src, i32 src_loc, i32 dst_loc, 
+                            u32 type);
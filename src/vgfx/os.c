@@ -1,4 +1,5 @@
 #include "os.h"
+#include "gl.h"
 
 #include <glfw/glfw3.h>
 
@@ -62,10 +63,12 @@ vgfx_os_window_open(VGFX_OS_WindowDesc *desc) {
 
     gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    _vgfx_gl_load_caps();
 
-    glEnable(GL_DEPTH_TEST);
+    vgfx_gl_set_blend(true);
+    vgfx_gl_set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    vgfx_gl_set_depth_test(true);
   }
 
   glfwSwapInterval(desc->vsync);
@@ -108,6 +111,8 @@ void
 vgfx_os_window_swap_buffers(VGFX_OS_WindowHandle win) {
 
   glfwSwapBuffers((GLFWwindow *)win);
+
+  vgfx_gl_state_end_frame();
 }
 
 // =============================================
@@ -121,10 +126,14 @@ vgfx_os_window_swap_buffers(VGFX_OS_WindowHandle win) {
 void 
 vgfx_os_poll_events() {
 
+  VGFX_PROFILE_BEGIN(vgfx_os_poll_events);
+
   vstd_map_iter(void *, VSTD_Vector(VGFX_OS_Event), s_os_event_map,
                 { vstd_vector_clear(VSTD_Vector(VGFX_OS_Event), _$iter.val); });
 
   glfwPollEvents();
+
+  VGFX_PROFILE_END(vgfx_os_poll_events);
 }
 
 VSTD_Vector(VGFX_OS_Event) 
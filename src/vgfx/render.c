@@ -2,6 +2,12 @@
 
 static VGFX_RD_Pipeline *s_rd_bound_pipeline;
 
+static VGFX_GL_Buffer     s_rd_quad_indices;
+
+static usize              s_rd_quad_index_refs;
+
+static VGFX_THREAD_LOCAL VGFX_RD_Recorder *s_rd_thread_recorder;
+
 // =============================================
 //
 //
@@ -11,79 +17,164 @@ static VGFX_RD_Pipeline *s_rd_bound_pipeline;
 // =============================================
 
 VGFX_RD_Pipeline *
-vgfx_rd_pipeline_new(VGFX_AS_AssetServer *as) {
+vgfx_rd_pipeline_new(VGFX_AS_AssetServer *as, VGFX_RD_PipelineDesc *desc) {
 
   VGFX_ASSERT_NON_NULL(as);
+  VGFX_ASSERT_NON_NULL(desc);
+
+  VGFX_RD_Pipeline *pipeline = (VGFX_RD_Pipeline*) calloc(1, sizeof(VGFX_RD_Pipeline));
 
-  VGFX_RD_Pipeline *pipeline = (VGFX_RD_Pipeline*) malloc(sizeof(VGFX_RD_Pipeline));
+  usize capacity = (desc->capacity) ? desc->capacity : VGFX_RD_DEFAULT_QUAD_COUNT;
+
+  // Indirect draws address their window with 16-bit indices and no chunking
+  if (desc->submit_mode == VGFX_RD_SUBMIT_MODE_INDIRECT && 
+      capacity > VGFX_RD_QUAD_INDEX_CHUNK) {
+    VGFX_DEBUG_WARN("Indirect pipelines are limited to `%d` quads.\n", 
+                    VGFX_RD_QUAD_INDEX_CHUNK);
+
+    capacity = VGFX_RD_QUAD_INDEX_CHUNK;
+  }
 
   // Properties
-  pipeline->max_vertex_count = VGFX_RD_MAX_VERTEX_COUNT;
-  pipeline->crn_vertex_count = 0;
-  pipeline->crn_index_count  = 0;
-  pipeline->crn_texture      = 0;
+  pipeline->mode               = desc->mode;
+  pipeline->max_vertex_count   = capacity * 4;
+  pipeline->crn_vertex_count   = 0;
+  pipeline->max_instance_count = capacity;
+  pipeline->crn_instance_count = 0;
+  pipeline->crn_index_count    = 0;
+  pipeline->crn_texture        = 0;
+  pipeline->texture_target     = (desc->texture_array) ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
 
   // Pipeline cache
   pipeline->_cache.texture        = VGFX_GL_INVALID_HANDLE;
+  pipeline->_cache.slot           = 0;
   pipeline->_cache.internal_flush = false;
+  pipeline->_cache.stamp          = 0;
+
+  // Deferred command queue
+  pipeline->sort.mode     = desc->sort_mode;
+  pipeline->sort.layer    = 0;
+  pipeline->sort.commands = vstd_vector_new(VGFX_RD_Command);
+  pipeline->sort.items    = vstd_vector_new(VGFX_RD_SortItem);
+
+  // Per-pass GPU timing, pipeline statistics only where the driver exposes them
+  pipeline->passes.enabled    = desc->gpu_timing;
+  pipeline->passes.statistics = desc->gpu_timing && vgfx_gl_caps()->pipeline_statistics;
+  pipeline->passes.count      = 0;
+  pipeline->passes.active     = -1;
+
+  // Stream settings, ring buffer requires sync objects
+  pipeline->stream.mode = desc->stream_mode;
+  if (pipeline->stream.mode == VGFX_RD_STREAM_MODE_RING && !GLAD_GL_VERSION_3_2) {
+    VGFX_DEBUG_WARN("Sync objects are not supported, falling back to orphaning.\n");
+
+    pipeline->stream.mode = VGFX_RD_STREAM_MODE_ORPHAN;
+  }
 
-  // OpenGL buffers
-  pipeline->vb = vgfx_gl_buffer_create(GL_ARRAY_BUFFER);
-  vgfx_gl_buffer_data(
-    &pipeline->vb, 
-    GL_DYNAMIC_DRAW, 
-    VGFX_RD_MAX_VERTEX_COUNT * sizeof(VGFX_RD_Vertex), 
-    NULL
-  );
-
-  pipeline->ib = vgfx_gl_buffer_create(GL_ELEMENT_ARRAY_BUFFER);
-  
-  pipeline->va = vgfx_gl_vertex_array_create();
+  // Indirect submission packs several texture windows into one draw call, array pipelines 
+  // select a page per draw
+  const usize units = vgfx_gl_caps()->max_texture_units;
 
-  VGFX_GL_VertexAttribLayout layout = {
-    .buffer = pipeline->vb,
-    .update_freq = 0,
-    .attribs = {
-      {1, GL_FLOAT, GL_FALSE},
-      {3, GL_FLOAT, GL_FALSE},
-      {2, GL_FLOAT, GL_FALSE},
-      {4, GL_FLOAT, GL_FALSE},
-    },
-  };
-  vgfx_gl_vertex_array_layout(&pipeline->va, &layout);
+  pipeline->indirect.mode        = desc->submit_mode;
+  pipeline->indirect.window      = (desc->texture_array) ? 1 : VGFX_RD_MAX_BOUND_TEXTURE;
+  pipeline->indirect.max_texture = 
+    (units < VGFX_RD_MAX_INDIRECT_TEXTURE) ? units : VGFX_RD_MAX_INDIRECT_TEXTURE;
 
-  vgfx_gl_vertex_array_index_buffer(&pipeline->va, &pipeline->ib);
+  if (pipeline->indirect.mode == VGFX_RD_SUBMIT_MODE_INDIRECT && 
+      (vgfx_gl_caps()->tier < VGFX_GL_TIER_INDIRECT || 
+       pipeline->mode != VGFX_RD_PIPELINE_MODE_BATCH)) {
+    VGFX_DEBUG_WARN("Indirect submission is not supported, falling back to direct.\n");
 
-  // CPU buffer
-  pipeline->cpu_vb = vstd_vector_with_capacity(
-        VGFX_RD_Vertex, VGFX_RD_MAX_VERTEX_COUNT);
+    pipeline->indirect.mode = VGFX_RD_SUBMIT_MODE_DIRECT;
+  }
 
-  // Send indices
-  VSTD_Vector(u32) tmp = vstd_vector_with_capacity(
-        u32, VGFX_RD_MAX_INDEX_COUNT);
+  // A single window would split nothing, direct submission is cheaper then
+  if (pipeline->indirect.mode == VGFX_RD_SUBMIT_MODE_INDIRECT && 
+      pipeline->indirect.max_texture < 2 * pipeline->indirect.window) {
+    VGFX_DEBUG_WARN("Not enough texture units for indirect submission, falling back to direct.\n");
 
-  usize offset = 0;
-  for (u32* ptr = (u32*)tmp.ptr; ptr < (u32*)tmp.ptr + VGFX_RD_MAX_INDEX_COUNT; ptr += 6) {
+    pipeline->indirect.mode = VGFX_RD_SUBMIT_MODE_DIRECT;
+  }
 
-    ptr[0] = offset + 1;
-    ptr[1] = offset + 3;
-    ptr[2] = offset + 2;
-    ptr[3] = offset + 1;
-    ptr[4] = offset + 0;
-    ptr[5] = offset + 2;
+  if (pipeline->indirect.mode == VGFX_RD_SUBMIT_MODE_INDIRECT) {
+    pipeline->indirect.buffer = vgfx_gl_buffer_create(GL_DRAW_INDIRECT_BUFFER);
+    vgfx_gl_buffer_data(&pipeline->indirect.buffer, GL_STREAM_DRAW, 
+                        sizeof(pipeline->indirect.draws), NULL);
+  }
 
-    offset += 4;
+  pipeline->stream.persistent = 
+    pipeline->stream.mode == VGFX_RD_STREAM_MODE_RING && vgfx_gl_caps()->buffer_storage;
+
+  pipeline->stream.segment       = 0;
+  pipeline->stream.segment_count = 
+    (pipeline->stream.mode == VGFX_RD_STREAM_MODE_RING) ? VGFX_RD_STREAM_SEGMENT_COUNT : 1;
+
+  // Instanced pipelines stream one record per quad instead of four vertices
+  VGFX_GL_VertexAttribLayout layout = _vgfx_rd_vertex_layout(pipeline->mode);
+
+  switch (pipeline->mode) {
+  case VGFX_RD_PIPELINE_MODE_BATCH:
+    pipeline->stream.stride   = sizeof(VGFX_RD_Vertex);
+    pipeline->stream.capacity = pipeline->max_vertex_count;
+    break;
+  case VGFX_RD_PIPELINE_MODE_INSTANCED:
+    pipeline->stream.stride   = sizeof(VGFX_RD_Instance);
+    pipeline->stream.capacity = pipeline->max_instance_count;
+    break;
+  default:
+    VGFX_ABORT("Unknown pipeline mode, `%d`.", pipeline->mode);
+    break;
+  }
+
+  // OpenGL buffers
+  const usize vb_size = pipeline->stream.capacity * pipeline->stream.stride;
+  const u32   vb_flag = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  // Instances are expanded from `gl_VertexID`, so no indices are needed
+  VGFX_GL_Buffer *ib = (pipeline->mode == VGFX_RD_PIPELINE_MODE_BATCH) 
+                         ? _vgfx_rd_quad_indices_acquire() 
+                         : NULL;
+
+  for (usize i = 0; i < pipeline->stream.segment_count; ++i) {
+    pipeline->vb[i] = vgfx_gl_buffer_create(GL_ARRAY_BUFFER);
+
+    switch (pipeline->stream.mode) {
+    case VGFX_RD_STREAM_MODE_SUB_DATA:
+      vgfx_gl_buffer_data(&pipeline->vb[i], GL_DYNAMIC_DRAW, vb_size, NULL);
+      break;
+    case VGFX_RD_STREAM_MODE_ORPHAN:
+      vgfx_gl_buffer_data(&pipeline->vb[i], GL_STREAM_DRAW, vb_size, NULL);
+      break;
+    case VGFX_RD_STREAM_MODE_RING:
+      if (!pipeline->stream.persistent) {
+        vgfx_gl_buffer_data(&pipeline->vb[i], GL_STREAM_DRAW, vb_size, NULL);
+        break;
+      }
+
+      vgfx_gl_buffer_storage(&pipeline->vb[i], vb_size, NULL, vb_flag);
+      pipeline->stream.mapped[i] = vgfx_gl_buffer_map_range(
+        &pipeline->vb[i], 0, vb_size, vb_flag);
+      break;
+    default:
+      VGFX_ABORT("Unknown stream mode, `%d`.", pipeline->stream.mode);
+      break;
+    }
+
+    pipeline->va[i] = vgfx_gl_vertex_array_create();
+
+    layout.buffer = pipeline->vb[i];
+    vgfx_gl_vertex_array_layout(&pipeline->va[i], &layout);
+
+    if (ib) {
+      vgfx_gl_vertex_array_index_buffer(&pipeline->va[i], ib);
+    }
   }
 
-  vgfx_gl_buffer_data(
-    &pipeline->ib,
-    GL_STATIC_DRAW,
-    VGFX_RD_MAX_INDEX_COUNT * sizeof(u32),
-    tmp.ptr
-  );
+  // CPU buffer
+  if (pipeline->stream.mode == VGFX_RD_STREAM_MODE_SUB_DATA) {
+    pipeline->cpu_vb = vstd_vector_with_capacity(u8, vb_size);
+  }
 
-  vstd_vector_free(u32, (&tmp));
-  
   return pipeline;
 }
 
@@ -92,266 +183,1955 @@ vgfx_rd_piepline_free(VGFX_RD_Pipeline *pipeline) {
 
   VGFX_ASSERT_NON_NULL(pipeline);
 
-  vgfx_gl_buffer_delete(&pipeline->vb);
-  vgfx_gl_buffer_delete(&pipeline->ib);
+  for (usize i = 0; i < pipeline->stream.segment_count; ++i) {
+    if (pipeline->stream.fences[i]) {
+      vgfx_gl_fence_delete(&pipeline->stream.fences[i]);
+    }
+
+    if (pipeline->stream.mapped[i]) {
+      vgfx_gl_buffer_unmap(&pipeline->vb[i]);
+    }
+
+    vgfx_gl_buffer_delete(&pipeline->vb[i]);
+    vgfx_gl_vertex_array_delete(&pipeline->va[i]);
+  }
+
+  if (pipeline->mode == VGFX_RD_PIPELINE_MODE_BATCH) {
+    _vgfx_rd_quad_indices_release();
+  }
+
+  if (pipeline->indirect.mode == VGFX_RD_SUBMIT_MODE_INDIRECT) {
+    vgfx_gl_buffer_delete(&pipeline->indirect.buffer);
+  }
+
+  if (pipeline->stream.mode == VGFX_RD_STREAM_MODE_SUB_DATA) {
+    vstd_vector_free(u8, (&pipeline->cpu_vb));
+  }
+
+  for (usize i = 0; i < pipeline->passes.count; ++i) {
+    _VGFX_RD_PassQueries *queries = &pipeline->passes.queries[i];
 
-  vgfx_gl_vertex_array_delete(&pipeline->va);
+    for (usize j = 0; j < VGFX_RD_QUERY_LATENCY; ++j) {
+      vgfx_gl_query_delete(&queries->time[j]);
+
+      if (pipeline->passes.statistics) {
+        vgfx_gl_query_delete(&queries->primitives[j]);
+        vgfx_gl_query_delete(&queries->fragments[j]);
+      }
+    }
+  }
 
-  vstd_vector_free(VGFX_RD_Vertex, (&pipeline->cpu_vb));
+  vstd_vector_free(VGFX_RD_Command, (&pipeline->sort.commands));
+  vstd_vector_free(VGFX_RD_SortItem, (&pipeline->sort.items));
+  free(pipeline->sort._scratch);
+  free(pipeline->sort._links);
 
   free(pipeline);
 }
 
 void
-vgfx_rd_pipeline_begin(VGFX_RD_Pipeline *pipeline, VGFX_AS_Asset *shader) {
+vgfx_rd_pipeline_begin(VGFX_RD_Pipeline *pipeline, VGFX_AS_Shader *shader) {
+
+  vgfx_rd_pipeline_begin_pass(pipeline, shader, NULL);
+}
+
+void
+vgfx_rd_pipeline_begin_pass(VGFX_RD_Pipeline *pipeline, VGFX_AS_Shader *shader, 
+                            const char *name) {
 
   VGFX_ASSERT_NON_NULL(pipeline);
 
   if (!pipeline->_cache.internal_flush) {
     VGFX_DEBUG_ASSERT(shader, "Handle is NULL.");
+
+    if (pipeline->passes.enabled) {
+      _vgfx_rd_pipeline_pass_begin(pipeline, (name) ? name : "unnamed");
+    }
     
-    VGFX_AS_Shader *handle;
-    VGFX_ASSET_CAST(shader, VGFX_ASSET_TYPE_SHADER, handle);
+    vgfx_gl_bind_shader_program(shader->handle);
+
+    pipeline->sort.shader        = shader;
+    pipeline->sort.opaque_shader = NULL;
 
-    vgfx_gl_bind_shader_program(handle->handle);
+    pipeline->_cache.texture_base = vgfx_as_shader_uniform(shader, "u_texture_base");
+
+    // Reset deferred commands
+    vstd_vector_clear(VGFX_RD_Command, (&pipeline->sort.commands));
+    vstd_vector_clear(VGFX_RD_SortItem, (&pipeline->sort.items));
+
+    pipeline->sort.layer              = 0;
+    pipeline->sort._sim_texture_count = 0;
+    pipeline->sort._sim_quad_count    = 0;
+
+    // Culling follows the camera set for this pass
+    pipeline->cull.enabled = false;
   }
 
   // Reset pipeline
-  pipeline->crn_vertex_count = 0;
-  pipeline->crn_index_count  = 0;
-  pipeline->crn_texture      = 0;
+  pipeline->crn_vertex_count   = 0;
+  pipeline->crn_instance_count = 0;
+  pipeline->crn_index_count    = 0;
+
+  pipeline->indirect.draw_count  = 0;
+  pipeline->indirect.first_index = 0;
+  pipeline->indirect.crn_texture = 0;
 
-  pipeline->_cache.texture        = VGFX_GL_INVALID_HANDLE;
   pipeline->_cache.internal_flush = false;
 
+  _vgfx_rd_pipeline_reset_textures(pipeline);
+
+  // Acquire vertex memory
+  _vgfx_rd_pipeline_stream_map(pipeline);
+
   s_rd_bound_pipeline = pipeline;
 }
 
 void
 vgfx_rd_pipeline_flush() {
 
-  if (!s_rd_bound_pipeline->crn_vertex_count) {
-    return;
+  VGFX_PROFILE_BEGIN(vgfx_rd_pipeline_flush);
+
+  VGFX_RD_Stats *stats = &s_rd_bound_pipeline->stats.crn;
+
+  if (!s_rd_bound_pipeline->_cache.internal_flush) {
+    stats->flush_user += 1;
+  }
+
+  // Emit deferred commands in sorted order
+  if (s_rd_bound_pipeline->sort.mode != VGFX_RD_SORT_MODE_NONE && 
+      !s_rd_bound_pipeline->_cache.internal_flush) {
+    _vgfx_rd_pipeline_replay(s_rd_bound_pipeline);
   }
 
-  // Send vertex data
-  vgfx_gl_buffer_sub_data(
-    &s_rd_bound_pipeline->vb, 
-    0, 
-    s_rd_bound_pipeline->crn_vertex_count * sizeof(VGFX_RD_Vertex), 
-    s_rd_bound_pipeline->cpu_vb.ptr
-  );
+  // Release vertex memory
+  _vgfx_rd_pipeline_stream_unmap(s_rd_bound_pipeline);
+
+  if (!s_rd_bound_pipeline->crn_vertex_count && !s_rd_bound_pipeline->crn_instance_count) {
+    if (!s_rd_bound_pipeline->_cache.internal_flush) {
+      _vgfx_rd_pipeline_pass_end(s_rd_bound_pipeline);
+    }
+
+    VGFX_PROFILE_END(vgfx_rd_pipeline_flush);
+    return;
+  }
 
   // Set textures
-  for (usize i = 0; i < s_rd_bound_pipeline->crn_texture; ++i) {
-    glActiveTexture(GL_TEXTURE0 + i);
-    glBindTexture(GL_TEXTURE_2D, s_rd_bound_pipeline->textures[i]);
+  if (s_rd_bound_pipeline->indirect.mode == VGFX_RD_SUBMIT_MODE_INDIRECT) {
+    _vgfx_rd_pipeline_close_draw(s_rd_bound_pipeline);
 
-    if (s_rd_bound_pipeline->_cache.internal_flush) {
-      continue;
+    for (usize i = 0; i < s_rd_bound_pipeline->indirect.crn_texture; ++i) {
+      vgfx_gl_bind_texture(
+        s_rd_bound_pipeline->texture_target, s_rd_bound_pipeline->indirect.textures[i], i);
+    }
+
+    stats->texture_binds += s_rd_bound_pipeline->indirect.crn_texture;
+
+    vgfx_gl_uniform_set_iv(s_rd_bound_pipeline->_cache.texture_base, 
+                           s_rd_bound_pipeline->indirect.draw_count, 
+                           s_rd_bound_pipeline->indirect.bases);
+  } else if (s_rd_bound_pipeline->texture_target == GL_TEXTURE_2D_ARRAY) {
+    vgfx_gl_bind_texture(GL_TEXTURE_2D_ARRAY, s_rd_bound_pipeline->textures[0], 0);
+
+    stats->texture_binds += 1;
+  } else {
+    // Sampler units were assigned when the shader was loaded
+    for (usize i = 0; i < s_rd_bound_pipeline->crn_texture; ++i) {
+      vgfx_gl_bind_texture(GL_TEXTURE_2D, s_rd_bound_pipeline->textures[i], i);
     }
 
-    VSTD_String tmp = vstd_string_format("u_texture[%lu]", i);
-    vgfx_gl_uniform_fv(tmp.ptr, 1, (f32[1]){i});
-    vstd_string_free(&tmp);
+    stats->texture_binds += s_rd_bound_pipeline->crn_texture;
   }
 
   // Draw the vertices
-  glBindVertexArray(s_rd_bound_pipeline->va.handle);
+  usize segment = s_rd_bound_pipeline->stream.segment;
+  usize draws   = 1;
+
+  vgfx_gl_bind_vertex_array(s_rd_bound_pipeline->va[segment].handle);
+
+  switch (s_rd_bound_pipeline->mode) {
+  case VGFX_RD_PIPELINE_MODE_BATCH:
+    if (s_rd_bound_pipeline->indirect.mode == VGFX_RD_SUBMIT_MODE_INDIRECT) {
+      const usize size = 
+        s_rd_bound_pipeline->indirect.draw_count * sizeof(VGFX_GL_DrawElementsIndirectCommand);
+
+      vgfx_gl_buffer_sub_data(
+        &s_rd_bound_pipeline->indirect.buffer, 0, size, s_rd_bound_pipeline->indirect.draws);
+
+      stats->bytes_streamed += size;
+
+      vgfx_gl_multi_draw_elements_indirect(
+        &s_rd_bound_pipeline->indirect.buffer, GL_TRIANGLES, GL_UNSIGNED_SHORT, 
+        s_rd_bound_pipeline->indirect.draw_count);
+      break;
+    }
+
+    draws = _vgfx_rd_draw_quads(0, s_rd_bound_pipeline->crn_index_count / 6);
+    break;
+  case VGFX_RD_PIPELINE_MODE_INSTANCED:
+    glDrawArraysInstanced(
+      GL_TRIANGLES, 0, 6, s_rd_bound_pipeline->crn_instance_count);
+    break;
+  }
+
+  if (s_rd_bound_pipeline->sort.mode != VGFX_RD_SORT_MODE_NONE) {
+    s_rd_bound_pipeline->sort.draws += 1;
+  }
 
-  glDrawElements(
-    GL_TRIANGLES, s_rd_bound_pipeline->crn_index_count, GL_UNSIGNED_INT, NULL);
+  stats->draws     += draws;
+  stats->vertices  += s_rd_bound_pipeline->crn_vertex_count;
+  stats->indices   += s_rd_bound_pipeline->crn_index_count;
+  stats->instances += s_rd_bound_pipeline->crn_instance_count;
+
+  // Guard the segment until GPU is done with it
+  if (s_rd_bound_pipeline->stream.mode == VGFX_RD_STREAM_MODE_RING) {
+    s_rd_bound_pipeline->stream.fences[segment] = vgfx_gl_fence_create();
+    s_rd_bound_pipeline->stream.segment = 
+      (segment + 1) % s_rd_bound_pipeline->stream.segment_count;
+  }
 
   if (!s_rd_bound_pipeline->_cache.internal_flush) {
+    if (s_rd_bound_pipeline->sort.mode == VGFX_RD_SORT_MODE_DEPTH) {
+      _vgfx_rd_pipeline_blend(s_rd_bound_pipeline, false);
+      vgfx_gl_set_depth_mask(true);
+    }
+
+    _vgfx_rd_pipeline_pass_end(s_rd_bound_pipeline);
     vgfx_gl_unbind_shader_program();
   }
 
   s_rd_bound_pipeline = NULL;
+
+  VGFX_PROFILE_END(vgfx_rd_pipeline_flush);
 }
 
-// =============================================
-//
-//
-// Render
-//
-//
-// =============================================
+VGFX_GL_VertexAttribLayout 
+_vgfx_rd_vertex_layout(VGFX_RD_PipelineMode mode) {
+
+  if (mode == VGFX_RD_PIPELINE_MODE_INSTANCED) {
+    return (VGFX_GL_VertexAttribLayout){
+      .stride = sizeof(VGFX_RD_Instance),
+      .update_freq = 1,
+      .attribs = {
+        {3, GL_FLOAT,          GL_FALSE, false, offsetof(VGFX_RD_Instance, pos)},
+        {2, GL_FLOAT,          GL_FALSE, false, offsetof(VGFX_RD_Instance, size)},
+        {1, GL_FLOAT,          GL_FALSE, false, offsetof(VGFX_RD_Instance, rot)},
+        {4, GL_UNSIGNED_SHORT, GL_TRUE,  false, offsetof(VGFX_RD_Instance, tex)},
+        {4, GL_UNSIGNED_BYTE,  GL_TRUE,  false, offsetof(VGFX_RD_Instance, col)},
+        {1, GL_UNSIGNED_BYTE,  GL_FALSE, true,  offsetof(VGFX_RD_Instance, texture)},
+      },
+    };
+  }
 
-void
-vgfx_rd_send_vert(f32 texture, vec3 pos, vec2 tex, vec4 col) {
+  return (VGFX_GL_VertexAttribLayout){
+    .stride = sizeof(VGFX_RD_Vertex),
+    .update_freq = 0,
+    .attribs = {
+      {3, GL_FLOAT,          GL_FALSE, false, offsetof(VGFX_RD_Vertex, pos)},
+      {2, GL_UNSIGNED_SHORT, GL_TRUE,  false, offsetof(VGFX_RD_Vertex, tex)},
+      {4, GL_UNSIGNED_BYTE,  GL_TRUE,  false, offsetof(VGFX_RD_Vertex, col)},
+      {1, GL_UNSIGNED_BYTE,  GL_FALSE, true,  offsetof(VGFX_RD_Vertex, texture)},
+    },
+  };
+}
 
-  if (s_rd_bound_pipeline->crn_vertex_count == s_rd_bound_pipeline->max_vertex_count) {
-    VGFX_RD_Pipeline *tmp = s_rd_bound_pipeline;
+void
+vgfx_rd_pipeline_end_frame(VGFX_RD_Pipeline *pipeline) {
 
-    s_rd_bound_pipeline->_cache.internal_flush = true;
+  VGFX_ASSERT_NON_NULL(pipeline);
 
-    vgfx_rd_pipeline_flush();
-    vgfx_rd_pipeline_begin(tmp, NULL);
+  VGFX_RD_Stats *crn   = &pipeline->stats.crn;
+  VGFX_RD_Stats *total = &pipeline->stats.total;
+
+  crn->frames = 1;
+
+  total->frames         += crn->frames;
+  total->draws          += crn->draws;
+  total->vertices       += crn->vertices;
+  total->indices        += crn->indices;
+  total->instances      += crn->instances;
+  total->bytes_streamed += crn->bytes_streamed;
+  total->texture_binds  += crn->texture_binds;
+  total->flush_user     += crn->flush_user;
+  total->flush_capacity += crn->flush_capacity;
+  total->flush_texture  += crn->flush_texture;
+  total->flush_order    += crn->flush_order;
+  total->culled         += crn->culled;
+
+  pipeline->stats.frame = *crn;
+  memset(crn, 0, sizeof(VGFX_RD_Stats));
+
+  // Collect whatever query results the GPU has finished, never wait on the rest
+  for (usize i = 0; i < pipeline->passes.count; ++i) {
+    _vgfx_rd_pipeline_pass_resolve(pipeline, i);
   }
-  
-  VGFX_RD_Vertex *v = &vstd_vector_get(
-    VGFX_RD_Vertex, 
-    s_rd_bound_pipeline->cpu_vb, 
-    s_rd_bound_pipeline->crn_vertex_count
-  );
+}
 
-  v->texture = texture;
+const VGFX_RD_Stats *
+vgfx_rd_pipeline_stats(VGFX_RD_Pipeline *pipeline, VGFX_RD_StatsScope scope) {
 
-  v->pos[0] = pos[0];
-  v->pos[1] = pos[1];
-  v->pos[2] = pos[2];
+  VGFX_ASSERT_NON_NULL(pipeline);
 
-  v->tex[0] = tex[0];
-  v->tex[1] = tex[1];
+  return (scope == VGFX_RD_STATS_SCOPE_TOTAL) ? &pipeline->stats.total 
+                                              : &pipeline->stats.frame;
+}
 
-  v->col[0] = col[0];
-  v->col[1] = col[1];
-  v->col[2] = col[2];
-  v->col[3] = col[3];
+const VGFX_RD_PassStats *
+vgfx_rd_pipeline_pass_stats(VGFX_RD_Pipeline *pipeline, usize *count) {
 
-  s_rd_bound_pipeline->crn_vertex_count += 1;
+  VGFX_ASSERT_NON_NULL(pipeline);
+  VGFX_ASSERT_NON_NULL(count);
+
+  *count = pipeline->passes.count;
+
+  return pipeline->passes.stats;
 }
 
-void
-vgfx_rd_send_quad(f32 texture, vec3 pos, vec2 scl, vec4 tex, vec4 col) {
+void 
+_vgfx_rd_pipeline_pass_begin(VGFX_RD_Pipeline *pipeline, const char *name) {
 
-  // Send vertices
-  vec3 tpos = {pos[0], pos[1], pos[2]};
-  vec2 ttex = {tex[0], tex[1] + tex[3]};
-  
-  vgfx_rd_send_vert(texture, tpos, ttex, col);
+  VGFX_ASSERT_NON_NULL(pipeline);
+  VGFX_ASSERT_NON_NULL(name);
 
-  tpos[0] += scl[0];
+  usize index = 0;
+  while (index < pipeline->passes.count && 
+         strncmp(pipeline->passes.stats[index].name, name, VGFX_RD_PASS_NAME_SIZE - 1)) {
+    index += 1;
+  }
 
-  ttex[0] += tex[2];
-  vgfx_rd_send_vert(texture, tpos, ttex, col);
+  _VGFX_RD_PassQueries *queries = &pipeline->passes.queries[index];
 
-  tpos[0] -= scl[0];
-  tpos[1] += scl[1];
+  // Register a new pass
+  if (index == pipeline->passes.count) {
+    if (pipeline->passes.count >= VGFX_RD_MAX_PASS_COUNT) {
+      VGFX_DEBUG_WARN("Too many timed passes, `%s` is not measured.\n", name);
+      return;
+    }
 
-  ttex[0] -= tex[2];
-  ttex[1] -= tex[3];
-  vgfx_rd_send_vert(texture, tpos, ttex, col);
+    VGFX_RD_PassStats *stats = &pipeline->passes.stats[index];
+    strncpy(stats->name, name, VGFX_RD_PASS_NAME_SIZE - 1);
 
-  tpos[0] += scl[0];
+    for (usize i = 0; i < VGFX_RD_QUERY_LATENCY; ++i) {
+      queries->time[i] = vgfx_gl_query_create();
 
-  ttex[0] += tex[2];
-  vgfx_rd_send_vert(texture, tpos, ttex, col);
+      if (pipeline->passes.statistics) {
+        queries->primitives[i] = vgfx_gl_query_create();
+        queries->fragments[i]  = vgfx_gl_query_create();
+      }
+    }
 
-  // Increase index count
-  s_rd_bound_pipeline->crn_index_count += 6;
-}
+    pipeline->passes.count += 1;
+  }
 
-void
-vgfx_rd_send_texture(VGFX_AS_Texture *handle, vec3 pos, vec2 scl, vec4 tex, vec4 col) {
+  _vgfx_rd_pipeline_pass_resolve(pipeline, index);
 
-  VGFX_DEBUG_ASSERT(handle, "Handle is NULL.");
+  // Every slot still in flight, skip this sample rather than stall
+  if (queries->head - queries->tail >= VGFX_RD_QUERY_LATENCY) {
+    pipeline->passes.stats[index].dropped += 1;
+    return;
+  }
 
-  isize slot = -1;
+  const usize slot = queries->head % VGFX_RD_QUERY_LATENCY;
 
-  if (handle->handle == s_rd_bound_pipeline->_cache.texture) {
-    slot = s_rd_bound_pipeline->crn_texture;    
-    goto render_quad;
+  vgfx_gl_query_begin(&queries->time[slot], GL_TIME_ELAPSED);
+
+  if (pipeline->passes.statistics) {
+    vgfx_gl_query_begin(&queries->primitives[slot], GL_PRIMITIVES_SUBMITTED);
+    vgfx_gl_query_begin(&queries->fragments[slot], GL_FRAGMENT_SHADER_INVOCATIONS);
   }
 
-  for (usize i = 0; i < VGFX_RD_MAX_BOUND_TEXTURE; ++i) {
-    if (handle->handle != s_rd_bound_pipeline->textures[i]) {
-      continue;
-    }
+  pipeline->passes.active = (isize)index;
+  pipeline->passes.start  = glfwGetTime();
+}
 
-    slot = i;
-    break;
+void 
+_vgfx_rd_pipeline_pass_end(VGFX_RD_Pipeline *pipeline) {
+
+  VGFX_ASSERT_NON_NULL(pipeline);
+
+  if (pipeline->passes.active < 0) {
+    return;
+  }
+
+  const usize index = (usize)pipeline->passes.active;
+
+  vgfx_gl_query_end(GL_TIME_ELAPSED);
+
+  if (pipeline->passes.statistics) {
+    vgfx_gl_query_end(GL_PRIMITIVES_SUBMITTED);
+    vgfx_gl_query_end(GL_FRAGMENT_SHADER_INVOCATIONS);
   }
 
-  if (slot < 0) {
-    if (s_rd_bound_pipeline->crn_texture == VGFX_RD_MAX_BOUND_TEXTURE) {
-      VGFX_RD_Pipeline *tmp = s_rd_bound_pipeline;
+  pipeline->passes.stats[index].cpu_time = 
+    (glfwGetTime() - pipeline->passes.start) * 1000.0;
+
+  pipeline->passes.queries[index].head += 1;
+  pipeline->passes.active = -1;
+}
+
+void 
+_vgfx_rd_pipeline_pass_resolve(VGFX_RD_Pipeline *pipeline, usize index) {
+
+  VGFX_ASSERT_NON_NULL(pipeline);
+  VGFX_DEBUG_ASSERT(index < pipeline->passes.count, "Index out of bounds.");
+
+  VGFX_RD_PassStats    *stats   = &pipeline->passes.stats[index];
+  _VGFX_RD_PassQueries *queries = &pipeline->passes.queries[index];
 
-      s_rd_bound_pipeline->_cache.internal_flush = true;
+  // Results become available in submission order
+  while (queries->tail < queries->head) {
+    const usize slot = queries->tail % VGFX_RD_QUERY_LATENCY;
 
-      vgfx_rd_pipeline_flush();
-      vgfx_rd_pipeline_begin(tmp, NULL);  
+    if (!vgfx_gl_query_available(&queries->time[slot]) || 
+        (pipeline->passes.statistics && 
+         !vgfx_gl_query_available(&queries->fragments[slot]))) {
+      break;
     }
-    
-    slot = s_rd_bound_pipeline->crn_texture;
 
-    s_rd_bound_pipeline->_cache.texture = handle->handle;
-    s_rd_bound_pipeline->textures[slot] = handle->handle;
+    stats->gpu_time = (f64)vgfx_gl_query_result(&queries->time[slot]) / 1000000.0;
 
-    s_rd_bound_pipeline->crn_texture += 1;
-  }
+    if (pipeline->passes.statistics) {
+      stats->primitives = vgfx_gl_query_result(&queries->primitives[slot]);
+      stats->fragments  = vgfx_gl_query_result(&queries->fragments[slot]);
+    }
 
-render_quad:
-  if (!tex) {
-    vgfx_rd_send_quad(slot, pos, scl, VGFX_RD_NO_SUB_TEXTURE, col);
-  } else {
-    vgfx_rd_send_quad(slot, pos, scl, tex, col);
+    stats->samples += 1;
+    queries->tail  += 1;
   }
 }
 
-void
-vgfx_rd_send_text(VGFX_AS_Font *handle, const char* str, vec3 pos, vec4 col) {
-
-  VGFX_DEBUG_ASSERT(handle, "Handle is NULL.");
+void 
+_vgfx_rd_pipeline_stream_map(VGFX_RD_Pipeline *pipeline) {
 
-  VGFX_AS_Texture tmp;
-  tmp.handle = handle->handle;
+  VGFX_ASSERT_NON_NULL(pipeline);
 
-  f32   offset = 0;
-  usize len    = strlen(str);
+  const usize size = pipeline->stream.capacity * pipeline->stream.stride;
 
-  for (usize i = 0; i < len; ++i) {
-    _VGFX_AS_Glyph *glyph = &vstd_vector_get(
-      _VGFX_AS_Glyph, handle->glyphs, ((usize)str[i] - handle->range[0])
+  switch (pipeline->stream.mode) {
+  case VGFX_RD_STREAM_MODE_SUB_DATA:
+    pipeline->vertices = (VGFX_RD_Vertex *)pipeline->cpu_vb.ptr;
+    break;
+  case VGFX_RD_STREAM_MODE_ORPHAN:
+    pipeline->vertices = vgfx_gl_buffer_map_range(
+      &pipeline->vb[0], 0, size, 
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | 
+      GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT
     );
+    break;
+  case VGFX_RD_STREAM_MODE_RING: {
+    usize          segment = pipeline->stream.segment;
+    VGFX_GL_Fence *fence   = &pipeline->stream.fences[segment];
 
-    vec3 tpos = {
-      pos[0] + offset + glyph->brng[0], 
-      pos[1] - (glyph->size[1] - glyph->brng[1]), 
-      pos[2],
-    };
+    // Wait until GPU stops reading from the segment
+    if (*fence) {
+      pipeline->stream.fence_checks += 1;
 
-    vec4 tex = {
-      glyph->offset,
-      0.0f,
-      glyph->size[0] / handle->size[0],
-      glyph->size[1] / handle->size[1],
-    };
+      if (vgfx_gl_fence_wait(fence)) {
+        pipeline->stream.fence_waits += 1;
+      }
 
-    vgfx_rd_send_texture(&tmp, tpos, glyph->size, tex, col);
+      vgfx_gl_fence_delete(fence);
+    }
 
-    offset += glyph->advn[0];
+    if (pipeline->stream.persistent) {
+      pipeline->vertices = pipeline->stream.mapped[segment];
+      break;
+    }
+
+    pipeline->vertices = vgfx_gl_buffer_map_range(
+      &pipeline->vb[segment], 0, size, 
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | 
+      GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT
+    );
+  } break;
   }
 }
 
-vec2s
-vgfx_rd_font_render_size(VGFX_AS_Font *handle, const char *str, bool fh) {
-  
-  VGFX_DEBUG_ASSERT(handle, "Handle is NULL.");
+void 
+_vgfx_rd_pipeline_stream_unmap(VGFX_RD_Pipeline *pipeline) {
 
-  VGFX_AS_Texture tmp;
-  tmp.handle = handle->handle;
+  VGFX_ASSERT_NON_NULL(pipeline);
 
-  usize len = strlen(str);
+  const usize count = (pipeline->mode == VGFX_RD_PIPELINE_MODE_INSTANCED)
+                        ? pipeline->crn_instance_count
+                        : pipeline->crn_vertex_count;
 
-  f32 w = 0;
-  f32 h = 0;
+  const usize    size = count * pipeline->stream.stride;
+  VGFX_GL_Buffer *vb  = &pipeline->vb[pipeline->stream.segment];
 
-  for (usize i = 0; i < len; ++i) {
-    _VGFX_AS_Glyph *glyph = &vstd_vector_get(
-      _VGFX_AS_Glyph, handle->glyphs, ((usize)str[i] - handle->range[0])
-    );
+  pipeline->stats.crn.bytes_streamed += size;
 
-    if (glyph->size[0] > h) {
-      h = glyph->size[0];
+  switch (pipeline->stream.mode) {
+  case VGFX_RD_STREAM_MODE_SUB_DATA:
+    if (size) {
+      vgfx_gl_buffer_sub_data(vb, 0, size, pipeline->cpu_vb.ptr);
+    }
+    break;
+  case VGFX_RD_STREAM_MODE_ORPHAN:
+  case VGFX_RD_STREAM_MODE_RING:
+    if (pipeline->stream.persistent) {
+      break;
     }
 
-    w += glyph->advn[0];
+    if (size) {
+      vgfx_gl_buffer_flush_range(vb, 0, size);
+    }
+
+    vgfx_gl_buffer_unmap(vb);
+    break;
   }
 
-  if (fh) {
-    h = handle->_average_glyph_height;
+  pipeline->vertices = NULL;
+}
+
+void 
+_vgfx_rd_pipeline_internal_flush(VGFX_RD_FlushCause cause) {
+
+  VGFX_RD_Pipeline *tmp = s_rd_bound_pipeline;
+
+  switch (cause) {
+  case VGFX_RD_FLUSH_CAUSE_CAPACITY:
+    tmp->stats.crn.flush_capacity += 1;
+    break;
+  case VGFX_RD_FLUSH_CAUSE_TEXTURE:
+    tmp->stats.crn.flush_texture += 1;
+    break;
+  case VGFX_RD_FLUSH_CAUSE_ORDER:
+    tmp->stats.crn.flush_order += 1;
+    break;
   }
 
-  return (vec2s) {.x = w, .y = h};
+  s_rd_bound_pipeline->_cache.internal_flush = true;
+
+  vgfx_rd_pipeline_flush();
+  vgfx_rd_pipeline_begin(tmp, NULL);
+}
+
+void 
+_vgfx_rd_pipeline_reset_textures(VGFX_RD_Pipeline *pipeline) {
+
+  pipeline->crn_texture    = 0;
+  pipeline->_cache.texture = VGFX_GL_INVALID_HANDLE;
+
+  // Invalidate texture table, stale stamps mark entries as free
+  pipeline->_cache.stamp += 1;
+  if (!pipeline->_cache.stamp) {
+    memset(pipeline->_cache.slots, 0, sizeof(pipeline->_cache.slots));
+    pipeline->_cache.stamp = 1;
+  }
+}
+
+bool 
+_vgfx_rd_pipeline_split() {
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  if (pipeline->indirect.mode != VGFX_RD_SUBMIT_MODE_INDIRECT) {
+    return false;
+  }
+
+  // Keep room for the closing draw and a full texture window
+  const usize textures = 
+    pipeline->indirect.crn_texture + pipeline->crn_texture + pipeline->indirect.window;
+
+  if (pipeline->indirect.draw_count + 2 > VGFX_RD_MAX_INDIRECT_DRAW || 
+      textures > pipeline->indirect.max_texture) {
+    return false;
+  }
+
+  _vgfx_rd_pipeline_close_draw(pipeline);
+  _vgfx_rd_pipeline_reset_textures(pipeline);
+
+  return true;
+}
+
+void 
+_vgfx_rd_pipeline_close_draw(VGFX_RD_Pipeline *pipeline) {
+
+  VGFX_ASSERT_NON_NULL(pipeline);
+
+  const usize count = pipeline->crn_index_count - pipeline->indirect.first_index;
+  if (!count) {
+    return;
+  }
+
+  // Texture slots of the draw are offset by its window base
+  const usize draw = pipeline->indirect.draw_count;
+
+  // Quad indices repeat, so the window is selected with its base vertex
+  pipeline->indirect.draws[draw] = (VGFX_GL_DrawElementsIndirectCommand){
+    .count = count,
+    .instance_count = 1,
+    .first_index = 0,
+    .base_vertex = (i32)(pipeline->indirect.first_index / 6 * 4),
+    .base_instance = 0,
+  };
+  pipeline->indirect.bases[draw] = (i32)pipeline->indirect.crn_texture;
+
+  memcpy(&pipeline->indirect.textures[pipeline->indirect.crn_texture], 
+         pipeline->textures, pipeline->crn_texture * sizeof(VGFX_AS_TextureHandle));
+
+  pipeline->indirect.crn_texture += pipeline->crn_texture;
+  pipeline->indirect.draw_count  += 1;
+  pipeline->indirect.first_index  = pipeline->crn_index_count;
+}
+
+VGFX_GL_Buffer *
+_vgfx_rd_quad_indices_acquire() {
+
+  s_rd_quad_index_refs += 1;
+  if (s_rd_quad_index_refs > 1) {
+    return &s_rd_quad_indices;
+  }
+
+  // One chunk of quads covers the whole 16-bit range, larger batches rebase it
+  const usize count = VGFX_RD_QUAD_INDEX_CHUNK * 6;
+
+  u16 *tmp = (u16 *)malloc(count * sizeof(u16));
+  VGFX_ASSERT(tmp, "Failed to allocate quad indices.");
+
+  u16 offset = 0;
+  for (u16 *ptr = tmp; ptr < tmp + count; ptr += 6) {
+
+    ptr[0] = offset + 1;
+    ptr[1] = offset + 3;
+    ptr[2] = offset + 2;
+    ptr[3] = offset + 1;
+    ptr[4] = offset + 0;
+    ptr[5] = offset + 2;
+
+    offset += 4;
+  }
+
+  s_rd_quad_indices = vgfx_gl_buffer_create(GL_ELEMENT_ARRAY_BUFFER);
+
+  if (vgfx_gl_caps()->buffer_storage) {
+    vgfx_gl_buffer_storage(&s_rd_quad_indices, count * sizeof(u16), tmp, 0);
+  } else {
+    vgfx_gl_buffer_data(&s_rd_quad_indices, GL_STATIC_DRAW, count * sizeof(u16), tmp);
+  }
+
+  free(tmp);
+
+  return &s_rd_quad_indices;
+}
+
+void 
+_vgfx_rd_quad_indices_release() {
+
+  VGFX_DEBUG_ASSERT(s_rd_quad_index_refs, "Quad indices are not acquired.");
+
+  s_rd_quad_index_refs -= 1;
+  if (!s_rd_quad_index_refs) {
+    vgfx_gl_buffer_delete(&s_rd_quad_indices);
+  }
+}
+
+usize 
+_vgfx_rd_draw_quads(usize first, usize count) {
+
+  usize draws = 0;
+
+  while (count) {
+    const usize len = (count < VGFX_RD_QUAD_INDEX_CHUNK) ? count : VGFX_RD_QUAD_INDEX_CHUNK;
+
+    glDrawElementsBaseVertex(
+      GL_TRIANGLES, len * 6, GL_UNSIGNED_SHORT, NULL, (i32)(first * 4));
+
+    first += len;
+    count -= len;
+    draws += 1;
+  }
+
+  return draws;
+}
+
+usize 
+_vgfx_rd_pipeline_reserve(usize count) {
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  usize free = (pipeline->mode == VGFX_RD_PIPELINE_MODE_INSTANCED)
+                 ? pipeline->max_instance_count - pipeline->crn_instance_count
+                 : (pipeline->max_vertex_count - pipeline->crn_vertex_count) / 4;
+
+  if (!free) {
+    _vgfx_rd_pipeline_internal_flush(VGFX_RD_FLUSH_CAUSE_CAPACITY);
+
+    free = (pipeline->mode == VGFX_RD_PIPELINE_MODE_INSTANCED)
+             ? pipeline->max_instance_count
+             : pipeline->max_vertex_count / 4;
+  }
+
+  return (count < free) ? count : free;
+}
+
+void 
+_vgfx_rd_pipeline_replay(VGFX_RD_Pipeline *pipeline) {
+
+  VGFX_ASSERT_NON_NULL(pipeline);
+
+  usize count = pipeline->sort.items.len;
+  if (!count) {
+    return;
+  }
+
+  // Account the draw the unsorted submission would have finished with
+  pipeline->sort.draws_unsorted += 1;
+
+  // Make sure radix sort has enough scratch memory
+  if (pipeline->sort._scratch_cap < count) {
+    pipeline->sort._scratch_cap = count;
+    pipeline->sort._scratch = (VGFX_RD_SortItem *)realloc(
+      pipeline->sort._scratch, count * sizeof(VGFX_RD_SortItem));
+
+    VGFX_ASSERT(pipeline->sort._scratch, "Failed to allocate sort buffer.");
+  }
+
+  VGFX_RD_SortItem *items = _vgfx_rd_radix_sort(
+    (VGFX_RD_SortItem *)pipeline->sort.items.ptr, pipeline->sort._scratch, count);
+
+  // Opaque quads sort first and draw without blending
+  const bool depth  = pipeline->sort.mode == VGFX_RD_SORT_MODE_DEPTH;
+  bool       opaque = depth && !(items[0].key >> 63);
+
+  if (depth) {
+    _vgfx_rd_pipeline_blend(pipeline, opaque);
+  }
+
+  // Emit the quads, texture changes now happen in sorted order
+  for (usize i = 0; i < count; ++i) {
+    if (opaque && (items[i].key >> 63)) {
+      _vgfx_rd_pipeline_internal_flush(VGFX_RD_FLUSH_CAUSE_ORDER);
+      _vgfx_rd_pipeline_blend(pipeline, false);
+
+      opaque = false;
+    }
+
+    VGFX_RD_Command *cmd = 
+      &vstd_vector_get(VGFX_RD_Command, pipeline->sort.commands, items[i].index);
+
+    _vgfx_rd_pipeline_reserve(1);
+
+    u8 slot = _vgfx_rd_texture_resolve(cmd->texture, cmd->layer);
+
+    _vgfx_rd_write_quad(slot, cmd->pos, cmd->scl, cmd->rot, cmd->tex, cmd->col);
+  }
+}
+
+VGFX_RD_SortItem *
+_vgfx_rd_radix_sort(VGFX_RD_SortItem *items, VGFX_RD_SortItem *scratch, usize count) {
+
+  // Histogram every key byte in a single pass
+  u32 hist[sizeof(u64)][256];
+  memset(hist, 0, sizeof(hist));
+
+  for (usize i = 0; i < count; ++i) {
+    u64 key = items[i].key;
+
+    for (usize b = 0; b < sizeof(u64); ++b) {
+      hist[b][(key >> (b * 8)) & 0xFF] += 1;
+    }
+  }
+
+  // LSD radix sort, stable, skips bytes which are equal in every key
+  VGFX_RD_SortItem *src = items;
+  VGFX_RD_SortItem *dst = scratch;
+
+  for (usize b = 0; b < sizeof(u64); ++b) {
+    const usize shift = b * 8;
+
+    if (hist[b][(src[0].key >> shift) & 0xFF] == count) {
+      continue;
+    }
+
+    u32 offset = 0;
+    for (usize i = 0; i < 256; ++i) {
+      u32 tmp = hist[b][i];
+      hist[b][i] = offset;
+      offset += tmp;
+    }
+
+    for (usize i = 0; i < count; ++i) {
+      dst[hist[b][(src[i].key >> shift) & 0xFF]++] = src[i];
+    }
+
+    VGFX_RD_SortItem *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  return src;
+}
+
+u64 
+_vgfx_rd_depth_key(f32 depth, bool opaque, u16 layer, VGFX_AS_TextureHandle texture) {
+
+  // Map the float to bits which order like the value
+  u32 bits;
+  memcpy(&bits, &depth, sizeof(bits));
+
+  bits = (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+
+  // Camera looks down -Z, opaque goes near to far in coarse buckets to keep textures together.
+  // The depth test orders opaque quads by z alone, so the layer isn't part of their key.
+  if (opaque) {
+    return ((u64)(~bits >> 17) << 32) | (u64)texture;
+  }
+
+  // Translucency in bit 63, then the layer, then depth. Equal depths keep submission 
+  // order through the stable sort, blending depends on it.
+  return (1ULL << 63) | ((u64)layer << 47) | ((u64)bits << 15);
+}
+
+void 
+_vgfx_rd_pipeline_blend(VGFX_RD_Pipeline *pipeline, bool opaque) {
+
+  VGFX_ASSERT_NON_NULL(pipeline);
+
+  vgfx_gl_set_blend(!opaque);
+  vgfx_gl_set_depth_mask(opaque);
+
+  if (!pipeline->sort.opaque_shader) {
+    return;
+  }
+
+  VGFX_AS_Shader *shader = (opaque) ? pipeline->sort.opaque_shader : pipeline->sort.shader;
+
+  vgfx_gl_bind_shader_program(shader->handle);
+
+  pipeline->_cache.texture_base = vgfx_as_shader_uniform(shader, "u_texture_base");
+}
+
+// =============================================
+//
+//
+// Render
+//
+//
+// =============================================
+
+void
+vgfx_rd_set_layer(u16 layer) {
+
+  if (s_rd_thread_recorder) {
+    s_rd_thread_recorder->layer = layer;
+    return;
+  }
+
+  s_rd_bound_pipeline->sort.layer = layer;
+}
+
+void
+vgfx_rd_set_camera(VGFX_RD_Camera *camera) {
+
+  VGFX_DEBUG_ASSERT(!s_rd_thread_recorder, "Camera can't be set while recording.");
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  pipeline->cull.enabled = camera != NULL;
+  if (!camera) {
+    return;
+  }
+
+  mat4 vpm;
+  vgfx_rd_camera_combined_matrix(camera, vpm);
+
+  glm_frustum_planes(vpm, pipeline->cull.planes);
+}
+
+void 
+vgfx_rd_set_opaque_shader(VGFX_AS_Shader *shader) {
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  VGFX_DEBUG_ASSERT(pipeline, "Opaque shader can only be set inside a pipeline pass.");
+
+  pipeline->sort.opaque_shader = shader;
+
+  if (!shader) {
+    return;
+  }
+
+  const u32 src = pipeline->sort.shader->handle;
+
+  // Locations are resolved once per pair of programs
+  if (pipeline->sort._link_src != src || pipeline->sort._link_dst != shader->handle) {
+    pipeline->sort._link_count = vgfx_gl_uniform_link(src, shader->handle, &pipeline->sort._links);
+    pipeline->sort._link_src   = src;
+    pipeline->sort._link_dst   = shader->handle;
+  }
+
+  // Uniforms set on the pass shader are written to the variant too, nothing is read back
+  vgfx_gl_uniform_mirror(src, shader->handle, pipeline->sort._links, pipeline->sort._link_count);
+}
+
+void
+vgfx_rd_send_vert(f32 texture, vec3 pos, vec2 tex, vec4 col) {
+
+  VGFX_DEBUG_ASSERT(!s_rd_thread_recorder, "Vertices can't be recorded.");
+  VGFX_DEBUG_ASSERT(s_rd_bound_pipeline->mode == VGFX_RD_PIPELINE_MODE_BATCH,
+                    "Vertices can only be sent to batch pipelines.");
+
+  if (s_rd_bound_pipeline->crn_vertex_count == s_rd_bound_pipeline->max_vertex_count) {
+    _vgfx_rd_pipeline_internal_flush(VGFX_RD_FLUSH_CAUSE_CAPACITY);
+  }
+  
+  VGFX_RD_Vertex *v = 
+    &s_rd_bound_pipeline->vertices[s_rd_bound_pipeline->crn_vertex_count];
+
+  v->pos[0] = pos[0];
+  v->pos[1] = pos[1];
+  v->pos[2] = pos[2];
+
+  v->tex[0] = VGFX_RD_PACK_UNORM16(tex[0]);
+  v->tex[1] = VGFX_RD_PACK_UNORM16(tex[1]);
+
+  v->col[0] = VGFX_RD_PACK_UNORM8(col[0]);
+  v->col[1] = VGFX_RD_PACK_UNORM8(col[1]);
+  v->col[2] = VGFX_RD_PACK_UNORM8(col[2]);
+  v->col[3] = VGFX_RD_PACK_UNORM8(col[3]);
+
+  v->texture = (texture < 0) ? VGFX_RD_NO_TEXTURE : (u8)texture;
+
+  s_rd_bound_pipeline->crn_vertex_count += 1;
+}
+
+void
+vgfx_rd_send_quad(f32 texture, vec3 pos, vec2 scl, vec4 tex, vec4 col) {
+
+  vgfx_rd_send_quad_rotated(texture, pos, scl, 0.0f, tex, col);
+}
+
+void
+vgfx_rd_send_quad_rotated(f32 texture, vec3 pos, vec2 scl, f32 rot, vec4 tex, vec4 col) {
+
+  const u8 pcol[4] = {
+    VGFX_RD_PACK_UNORM8(col[0]),
+    VGFX_RD_PACK_UNORM8(col[1]),
+    VGFX_RD_PACK_UNORM8(col[2]),
+    VGFX_RD_PACK_UNORM8(col[3]),
+  };
+
+  // Untextured quads don't depend on slots of a batch
+  if (s_rd_thread_recorder) {
+    VGFX_DEBUG_ASSERT(texture < 0, "Texture slots can't be recorded, send the texture instead.");
+
+    _vgfx_rd_recorder_push(s_rd_thread_recorder, 0, 0, true, pos, scl, rot, tex, pcol);
+    return;
+  }
+
+  if (_vgfx_rd_cull_quad(pos, scl, rot)) {
+    return;
+  }
+
+  if (s_rd_bound_pipeline->sort.mode != VGFX_RD_SORT_MODE_NONE) {
+    VGFX_DEBUG_ASSERT(texture < 0, "Texture slots can't be deferred, send the texture instead.");
+
+    _vgfx_rd_record_quad(0, 0, true, pos, scl, rot, tex, pcol);
+    return;
+  }
+
+  _vgfx_rd_pipeline_reserve(1);
+  _vgfx_rd_write_quad(
+    (texture < 0) ? VGFX_RD_NO_TEXTURE : (u8)texture, pos, scl, rot, tex, pcol);
+}
+
+void
+vgfx_rd_send_texture(VGFX_AS_Texture *handle, vec3 pos, vec2 scl, vec4 tex, vec4 col) {
+
+  vgfx_rd_send_texture_rotated(handle, pos, scl, 0.0f, tex, col);
+}
+
+void
+vgfx_rd_send_texture_rotated(VGFX_AS_Texture *handle, vec3 pos, vec2 scl, f32 rot, 
+                             vec4 tex, vec4 col) {
+
+  VGFX_DEBUG_ASSERT(handle, "Handle is NULL.");
+
+  const f32 *ttex = (tex) ? tex : VGFX_RD_NO_SUB_TEXTURE;
+
+  // Array layers only cover part of their page
+  const f32 stex[4] = {
+    ttex[0] * handle->uv_scale[0],
+    ttex[1] * handle->uv_scale[1],
+    ttex[2] * handle->uv_scale[0],
+    ttex[3] * handle->uv_scale[1],
+  };
+
+  const u8 pcol[4] = {
+    VGFX_RD_PACK_UNORM8(col[0]),
+    VGFX_RD_PACK_UNORM8(col[1]),
+    VGFX_RD_PACK_UNORM8(col[2]),
+    VGFX_RD_PACK_UNORM8(col[3]),
+  };
+
+  if (s_rd_thread_recorder) {
+    _vgfx_rd_recorder_push(
+      s_rd_thread_recorder, handle->handle, handle->layer, handle->opaque, pos, scl, rot, 
+      stex, pcol);
+    return;
+  }
+
+  VGFX_DEBUG_ASSERT(handle->target == s_rd_bound_pipeline->texture_target,
+                    "Texture target doesn't match the pipeline.");
+
+  if (_vgfx_rd_cull_quad(pos, scl, rot)) {
+    return;
+  }
+
+  if (s_rd_bound_pipeline->sort.mode != VGFX_RD_SORT_MODE_NONE) {
+    _vgfx_rd_record_quad(
+      handle->handle, handle->layer, handle->opaque, pos, scl, rot, stex, pcol);
+    return;
+  }
+
+  _vgfx_rd_pipeline_reserve(1);
+
+  u8 slot = _vgfx_rd_texture_resolve(handle->handle, handle->layer);
+
+  _vgfx_rd_write_quad(slot, pos, scl, rot, stex, pcol);
+}
+
+void
+vgfx_rd_send_texture_batch(VGFX_AS_Texture *handle, VGFX_RD_Sprite *sprites, usize count) {
+
+  VGFX_DEBUG_ASSERT(handle, "Handle is NULL.");
+  VGFX_DEBUG_ASSERT(sprites || !count, "Sprites are NULL.");
+
+  VGFX_PROFILE_BEGIN(vgfx_rd_send_texture_batch);
+
+  VGFX_RD_Recorder *recorder = s_rd_thread_recorder;
+
+  VGFX_DEBUG_ASSERT(recorder || handle->target == s_rd_bound_pipeline->texture_target,
+                    "Texture target doesn't match the pipeline.");
+
+  const bool deferred = recorder || s_rd_bound_pipeline->sort.mode != VGFX_RD_SORT_MODE_NONE;
+
+  u8 visible[VGFX_RD_CULL_BLOCK];
+
+  while (count) {
+    const usize block = (count < VGFX_RD_CULL_BLOCK) ? count : VGFX_RD_CULL_BLOCK;
+
+    // Sprites are culled as strided quad arrays
+    const VGFX_RD_QuadArrays bounds = {
+      .x = &sprites->pos[0],
+      .y = &sprites->pos[1],
+      .z = &sprites->pos[2],
+      .w = &sprites->scl[0],
+      .h = &sprites->scl[1],
+      .stride = sizeof(VGFX_RD_Sprite),
+    };
+
+    usize left = _vgfx_rd_cull_batch(&bounds, 0, block, visible);
+    usize i    = 0;
+
+    while (left) {
+      usize len = (deferred) ? left : _vgfx_rd_pipeline_reserve(left);
+
+      // Resolve the slot once for every sprite that fits into the batch
+      u8 slot = (deferred) ? 0 : _vgfx_rd_texture_resolve(handle->handle, handle->layer);
+
+      left -= len;
+
+      for (; len; ++i) {
+        if (!visible[i]) {
+          continue;
+        }
+
+        VGFX_RD_Sprite *sprite = &sprites[i];
+        len -= 1;
+
+        const f32 stex[4] = {
+          sprite->tex[0] * handle->uv_scale[0],
+          sprite->tex[1] * handle->uv_scale[1],
+          sprite->tex[2] * handle->uv_scale[0],
+          sprite->tex[3] * handle->uv_scale[1],
+        };
+
+        const u8 pcol[4] = {
+          VGFX_RD_PACK_UNORM8(sprite->col[0]),
+          VGFX_RD_PACK_UNORM8(sprite->col[1]),
+          VGFX_RD_PACK_UNORM8(sprite->col[2]),
+          VGFX_RD_PACK_UNORM8(sprite->col[3]),
+        };
+
+        if (recorder) {
+          _vgfx_rd_recorder_push(
+            recorder, handle->handle, handle->layer, handle->opaque, sprite->pos, sprite->scl, 
+            0.0f, stex, pcol);
+          continue;
+        }
+
+        if (deferred) {
+          _vgfx_rd_record_quad(
+            handle->handle, handle->layer, handle->opaque, sprite->pos, sprite->scl, 0.0f, 
+            stex, pcol);
+          continue;
+        }
+
+        _vgfx_rd_write_quad(slot, sprite->pos, sprite->scl, 0.0f, stex, pcol);
+      }
+    }
+
+    sprites += block;
+    count   -= block;
+  }
+
+  VGFX_PROFILE_END(vgfx_rd_send_texture_batch);
+}
+
+void
+vgfx_rd_send_quads(VGFX_AS_Texture *handle, const VGFX_RD_QuadArrays *quads, usize count) {
+
+  VGFX_DEBUG_ASSERT(quads, "Quads are NULL.");
+
+  VGFX_RD_Recorder *recorder = s_rd_thread_recorder;
+
+  VGFX_DEBUG_ASSERT(!handle || recorder || handle->target == s_rd_bound_pipeline->texture_target,
+                    "Texture target doesn't match the pipeline.");
+
+  const VGFX_AS_TextureHandle texture = (handle) ? handle->handle : 0;
+  const u32                   layer   = (handle) ? handle->layer : 0;
+  const f32                  *scale   = (handle) ? handle->uv_scale : (f32[2]){1.0f, 1.0f};
+  const bool                  opaque  = (handle) ? handle->opaque : true;
+
+  // Vertex expansion only applies to direct batch submission
+  if (recorder || 
+      s_rd_bound_pipeline->sort.mode != VGFX_RD_SORT_MODE_NONE || 
+      s_rd_bound_pipeline->mode != VGFX_RD_PIPELINE_MODE_BATCH) {
+    for (usize i = 0; i < count; ++i) {
+      f32 pos[3], scl[2], tex[4];
+      u8  col[4];
+      _vgfx_rd_quad_arrays_fetch(quads, i, scale, pos, scl, tex, col);
+
+      if (!recorder && _vgfx_rd_cull_quad(pos, scl, 0.0f)) {
+        continue;
+      }
+
+      if (recorder) {
+        _vgfx_rd_recorder_push(recorder, texture, layer, opaque, pos, scl, 0.0f, tex, col);
+      } else if (s_rd_bound_pipeline->sort.mode != VGFX_RD_SORT_MODE_NONE) {
+        _vgfx_rd_record_quad(texture, layer, opaque, pos, scl, 0.0f, tex, col);
+      } else {
+        _vgfx_rd_pipeline_reserve(1);
+        _vgfx_rd_write_quad(
+          _vgfx_rd_texture_resolve(texture, layer), pos, scl, 0.0f, tex, col);
+      }
+    }
+
+    return;
+  }
+
+  if (!s_rd_bound_pipeline->cull.enabled) {
+    _vgfx_rd_expand_range(texture, layer, scale, quads, 0, count);
+    return;
+  }
+
+  // Expand runs of visible quads
+  u8 visible[VGFX_RD_CULL_BLOCK];
+
+  for (usize base = 0; base < count; base += VGFX_RD_CULL_BLOCK) {
+    const usize block = (count - base < VGFX_RD_CULL_BLOCK) ? count - base : VGFX_RD_CULL_BLOCK;
+
+    _vgfx_rd_cull_batch(quads, base, block, visible);
+
+    usize i = 0;
+    while (i < block) {
+      while (i < block && !visible[i]) {
+        i += 1;
+      }
+
+      const usize first = i;
+      while (i < block && visible[i]) {
+        i += 1;
+      }
+
+      if (i > first) {
+        _vgfx_rd_expand_range(texture, layer, scale, quads, base + first, i - first);
+      }
+    }
+  }
+}
+
+void
+vgfx_rd_send_text(VGFX_AS_Font *handle, const char* str, vec3 pos, vec4 col) {
+
+  VGFX_DEBUG_ASSERT(handle, "Handle is NULL.");
+  VGFX_DEBUG_ASSERT(s_rd_thread_recorder || s_rd_bound_pipeline->texture_target == GL_TEXTURE_2D,
+                    "Array pipelines can't draw text, use a 2D pipeline.");
+
+  VGFX_AS_Texture tmp = {
+    .handle = handle->handle,
+    .target = GL_TEXTURE_2D,
+    .uv_scale = {1.0f, 1.0f},
+  };
+
+  VGFX_PROFILE_BEGIN(vgfx_rd_send_text);
+
+  f32   offset = 0;
+  usize len    = strlen(str);
+
+  for (usize i = 0; i < len; ++i) {
+    _VGFX_AS_Glyph *glyph = &vstd_vector_get(
+      _VGFX_AS_Glyph, handle->glyphs, ((usize)str[i] - handle->range[0])
+    );
+
+    vec3 tpos = {
+      pos[0] + offset + glyph->brng[0], 
+      pos[1] - (glyph->size[1] - glyph->brng[1]), 
+      pos[2],
+    };
+
+    vec4 tex = {
+      glyph->offset,
+      0.0f,
+      glyph->size[0] / handle->size[0],
+      glyph->size[1] / handle->size[1],
+    };
+
+    vgfx_rd_send_texture(&tmp, tpos, glyph->size, tex, col);
+
+    offset += glyph->advn[0];
+  }
+
+  VGFX_PROFILE_END(vgfx_rd_send_text);
+}
+
+void
+vgfx_rd_send_stats(VGFX_AS_Font *handle, const VGFX_RD_Stats *stats, vec3 pos, vec4 col) {
+
+  VGFX_DEBUG_ASSERT(handle, "Handle is NULL.");
+  VGFX_DEBUG_ASSERT(stats, "Stats are NULL.");
+
+  char lines[6][64];
+
+  snprintf(lines[0], sizeof(lines[0]), "DRW: %zu CUL: %zu", stats->draws, stats->culled);
+  snprintf(lines[1], sizeof(lines[1]), "VTX: %zu IDX: %zu INS: %zu", 
+           stats->vertices, stats->indices, stats->instances);
+  snprintf(lines[2], sizeof(lines[2]), "UPL: %.2f KiB", stats->bytes_streamed / 1024.0);
+  snprintf(lines[3], sizeof(lines[3]), "TEX: %zu", stats->texture_binds);
+  snprintf(lines[4], sizeof(lines[4]), "FLS: %zu CAP: %zu TEX: %zu ORD: %zu", 
+           stats->flush_user, stats->flush_capacity, stats->flush_texture, 
+           stats->flush_order);
+  snprintf(lines[5], sizeof(lines[5]), "FRM: %zu", stats->frames);
+
+  // Lines grow downwards from the given position
+  vec3 tpos = {pos[0], pos[1], pos[2]};
+
+  for (usize i = 0; i < sizeof(lines) / sizeof(lines[0]); ++i) {
+    tpos[1] -= handle->_average_glyph_height;
+
+    vgfx_rd_send_text(handle, lines[i], tpos, col);
+  }
+}
+
+vec2s
+vgfx_rd_font_render_size(VGFX_AS_Font *handle, const char *str, bool fh) {
+  
+  VGFX_DEBUG_ASSERT(handle, "Handle is NULL.");
+
+  VGFX_AS_Texture tmp;
+  tmp.handle = handle->handle;
+
+  usize len = strlen(str);
+
+  f32 w = 0;
+  f32 h = 0;
+
+  for (usize i = 0; i < len; ++i) {
+    _VGFX_AS_Glyph *glyph = &vstd_vector_get(
+      _VGFX_AS_Glyph, handle->glyphs, ((usize)str[i] - handle->range[0])
+    );
+
+    if (glyph->size[0] > h) {
+      h = glyph->size[0];
+    }
+
+    w += glyph->advn[0];
+  }
+
+  if (fh) {
+    h = handle->_average_glyph_height;
+  }
+
+  return (vec2s) {.x = w, .y = h};
+}
+
+bool
+_vgfx_rd_cull_quad(const f32 *pos, const f32 *scl, f32 rot) {
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  if (!pipeline->cull.enabled) {
+    return false;
+  }
+
+  // Rotated quads are bounded by the circle around their center
+  f32 hw = fabsf(scl[0]) * 0.5f;
+  f32 hh = fabsf(scl[1]) * 0.5f;
+
+  if (rot != 0.0f) {
+    hw = hh = sqrtf(hw * hw + hh * hh);
+  }
+
+  const f32 cx = pos[0] + scl[0] * 0.5f;
+  const f32 cy = pos[1] + scl[1] * 0.5f;
+
+  for (usize p = 0; p < 6; ++p) {
+    const f32 *plane = pipeline->cull.planes[p];
+
+    const f32 d = plane[0] * cx + plane[1] * cy + plane[2] * pos[2] + plane[3] + 
+                  fabsf(plane[0]) * hw + fabsf(plane[1]) * hh;
+
+    if (d < 0.0f) {
+      pipeline->stats.crn.culled += 1;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+usize
+_vgfx_rd_cull_batch(const VGFX_RD_QuadArrays *quads, usize first, usize count, u8 *visible) {
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  // Recorded quads are culled once they are merged
+  if (s_rd_thread_recorder || !pipeline->cull.enabled) {
+    memset(visible, 1, count);
+    return count;
+  }
+
+  const usize n = _vgfx_rd_cull_quads(quads, first, count, pipeline->cull.planes, visible);
+
+  pipeline->stats.crn.culled += count - n;
+
+  return n;
+}
+
+void
+_vgfx_rd_expand_range(VGFX_AS_TextureHandle texture, u32 layer, const f32 *uv_scale, 
+                      const VGFX_RD_QuadArrays *quads, usize first, usize count) {
+
+  // Expand in chunks which fit the remaining capacity
+  while (count) {
+    usize len = _vgfx_rd_pipeline_reserve(count);
+    u8    slot = _vgfx_rd_texture_resolve(texture, layer);
+
+    VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+    _vgfx_rd_expand_quads(
+      &pipeline->vertices[pipeline->crn_vertex_count], quads, first, len, slot, uv_scale);
+
+    pipeline->crn_vertex_count += len * 4;
+    pipeline->crn_index_count  += len * 6;
+
+    first += len;
+    count -= len;
+  }
+}
+
+void
+_vgfx_rd_write_quad(u8 texture, const f32 *pos, const f32 *scl, f32 rot, 
+                    const f32 *tex, const u8 *col) {
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  // Caller reserves capacity, see `_vgfx_rd_pipeline_reserve`
+  VGFX_DEBUG_ASSERT(
+    (pipeline->mode == VGFX_RD_PIPELINE_MODE_INSTANCED)
+      ? pipeline->crn_instance_count < pipeline->max_instance_count
+      : pipeline->crn_vertex_count + 4 <= pipeline->max_vertex_count,
+    "Pipeline is out of capacity.");
+
+  // Instanced pipelines expand the quad on GPU
+  if (pipeline->mode == VGFX_RD_PIPELINE_MODE_INSTANCED) {
+    VGFX_RD_Instance *v = &pipeline->instances[pipeline->crn_instance_count];
+
+    v->pos[0] = pos[0];
+    v->pos[1] = pos[1];
+    v->pos[2] = pos[2];
+
+    v->size[0] = scl[0];
+    v->size[1] = scl[1];
+
+    v->rot = rot;
+
+    v->tex[0] = VGFX_RD_PACK_UNORM16(tex[0]);
+    v->tex[1] = VGFX_RD_PACK_UNORM16(tex[1]);
+    v->tex[2] = VGFX_RD_PACK_UNORM16(tex[2]);
+    v->tex[3] = VGFX_RD_PACK_UNORM16(tex[3]);
+
+    memcpy(v->col, col, sizeof(v->col));
+
+    v->texture = texture;
+
+    pipeline->crn_instance_count += 1;
+    return;
+  }
+
+  _vgfx_rd_build_quad(
+    &pipeline->vertices[pipeline->crn_vertex_count], texture, pos, scl, rot, tex, col);
+
+  pipeline->crn_vertex_count += 4;
+  pipeline->crn_index_count  += 6;
+}
+
+void
+_vgfx_rd_build_quad(VGFX_RD_Vertex *v, u8 texture, const f32 *pos, const f32 *scl, 
+                    f32 rot, const f32 *tex, const u8 *col) {
+
+  // Corners in vertex order, UVs are flipped vertically
+  f32 x[4] = {0.0f, scl[0], 0.0f, scl[0]};
+  f32 y[4] = {0.0f, 0.0f, scl[1], scl[1]};
+
+  const u16 u[2] = {
+    VGFX_RD_PACK_UNORM16(tex[0]), 
+    VGFX_RD_PACK_UNORM16(tex[0] + tex[2]),
+  };
+  const u16 w[2] = {
+    VGFX_RD_PACK_UNORM16(tex[1] + tex[3]), 
+    VGFX_RD_PACK_UNORM16(tex[1]),
+  };
+
+  // Rotate corners around the center of the quad
+  if (rot != 0.0f) {
+    const f32 c = cosf(rot);
+    const f32 s = sinf(rot);
+
+    for (usize i = 0; i < 4; ++i) {
+      f32 lx = x[i] - scl[0] * 0.5f;
+      f32 ly = y[i] - scl[1] * 0.5f;
+
+      x[i] = scl[0] * 0.5f + lx * c - ly * s;
+      y[i] = scl[1] * 0.5f + lx * s + ly * c;
+    }
+  }
+
+  for (usize i = 0; i < 4; ++i) {
+    v[i].pos[0] = pos[0] + x[i];
+    v[i].pos[1] = pos[1] + y[i];
+    v[i].pos[2] = pos[2];
+
+    v[i].tex[0] = u[i & 1];
+    v[i].tex[1] = w[i >> 1];
+
+    memcpy(v[i].col, col, sizeof(v[i].col));
+
+    v[i].texture = texture;
+  }
+}
+
+void 
+_vgfx_rd_quad_arrays_fetch(const VGFX_RD_QuadArrays *quads, usize index, const f32 *uv_scale, 
+                           f32 *pos, f32 *scl, f32 *tex, u8 *col) {
+
+  const usize offset = index * ((quads->stride) ? quads->stride : sizeof(f32));
+
+  #define _VGFX_RD_FETCH(field) (*(const f32 *)((const u8 *)quads->field + offset))
+
+  pos[0] = _VGFX_RD_FETCH(x);
+  pos[1] = _VGFX_RD_FETCH(y);
+  pos[2] = _VGFX_RD_FETCH(z);
+
+  scl[0] = _VGFX_RD_FETCH(w);
+  scl[1] = _VGFX_RD_FETCH(h);
+
+  if (quads->tex_x) {
+    tex[0] = _VGFX_RD_FETCH(tex_x) * uv_scale[0];
+    tex[1] = _VGFX_RD_FETCH(tex_y) * uv_scale[1];
+    tex[2] = _VGFX_RD_FETCH(tex_w) * uv_scale[0];
+    tex[3] = _VGFX_RD_FETCH(tex_h) * uv_scale[1];
+  } else {
+    tex[0] = 0.0f;
+    tex[1] = 0.0f;
+    tex[2] = uv_scale[0];
+    tex[3] = uv_scale[1];
+  }
+
+  #undef _VGFX_RD_FETCH
+
+  if (quads->col) {
+    memcpy(col, (const u8 *)quads->col + offset, sizeof(u32));
+  } else {
+    memset(col, 0xFF, sizeof(u32));
+  }
+}
+
+void
+_vgfx_rd_record_quad(VGFX_AS_TextureHandle texture, u32 layer, bool opaque, const f32 *pos, 
+                     const f32 *scl, f32 rot, const f32 *tex, const u8 *col) {
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  // Painter's order only sorts by layer, radix sort keeps submission order
+  u64 key;
+  switch (pipeline->sort.mode) {
+  case VGFX_RD_SORT_MODE_STABLE:
+    key = VGFX_RD_SORT_KEY(pipeline->sort.layer, 0);
+    break;
+  case VGFX_RD_SORT_MODE_DEPTH:
+    key = _vgfx_rd_depth_key(pos[2], opaque && col[3] == 0xFF, pipeline->sort.layer, texture);
+    break;
+  default:
+    key = VGFX_RD_SORT_KEY(pipeline->sort.layer, texture);
+    break;
+  }
+
+  VGFX_RD_SortItem item = {
+    .key = key,
+    .index = pipeline->sort.commands.len,
+  };
+  vstd_vector_push(VGFX_RD_SortItem, (&pipeline->sort.items), item);
+
+  VGFX_RD_Command cmd;
+  cmd.texture    = texture;
+  cmd.layer      = layer;
+  cmd.sort_layer = pipeline->sort.layer;
+  cmd.opaque     = opaque;
+  cmd.rot        = rot;
+  memcpy(cmd.pos, pos, sizeof(cmd.pos));
+  memcpy(cmd.scl, scl, sizeof(cmd.scl));
+  memcpy(cmd.tex, tex, sizeof(cmd.tex));
+  memcpy(cmd.col, col, sizeof(cmd.col));
+  vstd_vector_push(VGFX_RD_Command, (&pipeline->sort.commands), cmd);
+
+  // Track how many draws the submission order would have needed
+  const usize quad_cap = (pipeline->mode == VGFX_RD_PIPELINE_MODE_INSTANCED)
+                           ? pipeline->max_instance_count
+                           : pipeline->max_vertex_count / 4;
+
+  bool resident = 
+    !texture || 
+    (pipeline->sort._sim_texture_count && texture == pipeline->sort._sim_textures[0]);
+  for (usize i = 1; i < pipeline->sort._sim_texture_count && !resident; ++i) {
+    resident = pipeline->sort._sim_textures[i] == texture;
+  }
+
+  if (!resident) {
+    if (pipeline->sort._sim_texture_count == VGFX_RD_MAX_BOUND_TEXTURE) {
+      pipeline->sort.draws_unsorted    += 1;
+      pipeline->sort._sim_texture_count = 0;
+      pipeline->sort._sim_quad_count    = 0;
+    }
+
+    pipeline->sort._sim_textures[pipeline->sort._sim_texture_count++] = texture;
+  }
+
+  if (++pipeline->sort._sim_quad_count == quad_cap) {
+    pipeline->sort.draws_unsorted    += 1;
+    pipeline->sort._sim_texture_count = 0;
+    pipeline->sort._sim_quad_count    = 0;
+  }
+}
+
+u8
+_vgfx_rd_texture_resolve(VGFX_AS_TextureHandle texture, u32 layer) {
+
+  if (!texture) {
+    return VGFX_RD_NO_TEXTURE;
+  }
+
+  return (s_rd_bound_pipeline->texture_target == GL_TEXTURE_2D_ARRAY)
+           ? _vgfx_rd_texture_layer(texture, layer)
+           : _vgfx_rd_texture_slot(texture);
+}
+
+u8
+_vgfx_rd_texture_slot(VGFX_AS_TextureHandle texture) {
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  if (texture == pipeline->_cache.texture) {
+    return pipeline->_cache.slot;
+  }
+
+  // Direct-mapped table with linear probing, entries from older batches are free
+  const u32 mask = VGFX_RD_TEXTURE_TABLE_SIZE - 1;
+
+  u32 index = (texture * 2654435761u) & mask;
+  _VGFX_RD_TextureEntry *entry = &pipeline->_cache.slots[index];
+
+  while (entry->stamp == pipeline->_cache.stamp) {
+    if (entry->texture == texture) {
+      pipeline->_cache.texture = texture;
+      pipeline->_cache.slot    = entry->slot;
+
+      return entry->slot;
+    }
+
+    index = (index + 1) & mask;
+    entry = &pipeline->_cache.slots[index];
+  }
+
+  // Assign the next slot, the table is empty after a flush or split
+  if (pipeline->crn_texture == VGFX_RD_MAX_BOUND_TEXTURE) {
+    if (!_vgfx_rd_pipeline_split()) {
+      _vgfx_rd_pipeline_internal_flush(VGFX_RD_FLUSH_CAUSE_TEXTURE);
+    }
+
+    index = (texture * 2654435761u) & mask;
+    entry = &pipeline->_cache.slots[index];
+  }
+
+  u8 slot = pipeline->crn_texture;
+
+  *entry = (_VGFX_RD_TextureEntry){
+    .texture = texture,
+    .stamp = pipeline->_cache.stamp,
+    .slot = slot,
+  };
+
+  pipeline->textures[slot] = texture;
+  pipeline->crn_texture   += 1;
+
+  pipeline->_cache.texture = texture;
+  pipeline->_cache.slot    = slot;
+
+  return slot;
+}
+
+u8
+_vgfx_rd_texture_layer(VGFX_AS_TextureHandle array, u32 layer) {
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  // A draw samples a single array, any of its layers can be used
+  if (pipeline->crn_texture && pipeline->textures[0] != array) {
+    if (!_vgfx_rd_pipeline_split()) {
+      _vgfx_rd_pipeline_internal_flush(VGFX_RD_FLUSH_CAUSE_TEXTURE);
+    }
+  }
+
+  if (!pipeline->crn_texture) {
+    pipeline->textures[0] = array;
+    pipeline->crn_texture = 1;
+  }
+
+  return (u8)layer;
+}
+
+// =============================================
+//
+//
+// Recorder
+//
+//
+// =============================================
+
+VGFX_RD_Recorder *
+vgfx_rd_recorder_new() {
+
+  VGFX_RD_Recorder *recorder = (VGFX_RD_Recorder *) malloc(sizeof(VGFX_RD_Recorder));
+
+  recorder->commands = vstd_vector_new(VGFX_RD_Command);
+  recorder->layer    = 0;
+
+  return recorder;
+}
+
+void 
+vgfx_rd_recorder_free(VGFX_RD_Recorder *recorder) {
+
+  VGFX_ASSERT_NON_NULL(recorder);
+
+  vstd_vector_free(VGFX_RD_Command, (&recorder->commands));
+
+  free(recorder);
+}
+
+void 
+vgfx_rd_recorder_begin(VGFX_RD_Recorder *recorder) {
+
+  VGFX_ASSERT_NON_NULL(recorder);
+  VGFX_DEBUG_ASSERT(!s_rd_thread_recorder, "Thread is already recording.");
+
+  // Keeps the allocation of the previous frame
+  vstd_vector_clear(VGFX_RD_Command, (&recorder->commands));
+  recorder->layer = 0;
+
+  s_rd_thread_recorder = recorder;
+}
+
+void 
+vgfx_rd_recorder_end() {
+
+  VGFX_DEBUG_ASSERT(s_rd_thread_recorder, "Thread isn't recording.");
+
+  s_rd_thread_recorder = NULL;
+}
+
+void 
+vgfx_rd_pipeline_merge(VGFX_RD_Recorder **recorders, usize count) {
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  VGFX_DEBUG_ASSERT(pipeline, "Recorders can only be merged inside a pipeline pass.");
+  VGFX_DEBUG_ASSERT(!s_rd_thread_recorder, "Recorders can't be merged while recording.");
+
+  const u16 layer = pipeline->sort.layer;
+
+  // Recorders are merged in array order, so the result doesn't depend on timing
+  for (usize i = 0; i < count; ++i) {
+    vstd_vector_iter(VGFX_RD_Command, recorders[i]->commands, {
+      if (_vgfx_rd_cull_quad(_$iter->pos, _$iter->scl, _$iter->rot)) {
+        continue;
+      }
+
+      if (pipeline->sort.mode != VGFX_RD_SORT_MODE_NONE) {
+        pipeline->sort.layer = _$iter->sort_layer;
+
+        _vgfx_rd_record_quad(_$iter->texture, _$iter->layer, _$iter->opaque, _$iter->pos, 
+                             _$iter->scl, _$iter->rot, _$iter->tex, _$iter->col);
+        continue;
+      }
+
+      _vgfx_rd_pipeline_reserve(1);
+
+      u8 slot = _vgfx_rd_texture_resolve(_$iter->texture, _$iter->layer);
+
+      _vgfx_rd_write_quad(
+        slot, _$iter->pos, _$iter->scl, _$iter->rot, _$iter->tex, _$iter->col);
+    });
+  }
+
+  pipeline->sort.layer = layer;
+}
+
+void 
+_vgfx_rd_recorder_push(VGFX_RD_Recorder *recorder, VGFX_AS_TextureHandle texture, u32 layer, 
+                       bool opaque, const f32 *pos, const f32 *scl, f32 rot, const f32 *tex, 
+                       const u8 *col) {
+
+  const f32 *ttex = (tex) ? tex : VGFX_RD_NO_SUB_TEXTURE;
+
+  VGFX_RD_Command cmd;
+  cmd.texture    = texture;
+  cmd.layer      = layer;
+  cmd.sort_layer = recorder->layer;
+  cmd.opaque     = opaque;
+  cmd.rot        = rot;
+  memcpy(cmd.pos, pos, sizeof(cmd.pos));
+  memcpy(cmd.scl, scl, sizeof(cmd.scl));
+  memcpy(cmd.tex, ttex, sizeof(cmd.tex));
+  memcpy(cmd.col, col, sizeof(cmd.col));
+  vstd_vector_push(VGFX_RD_Command, (&recorder->commands), cmd);
+}
+
+// =============================================
+//
+//
+// Static Batch
+//
+//
+// =============================================
+
+VGFX_RD_StaticBatch *
+vgfx_rd_static_batch_new(VGFX_RD_Pipeline *pipeline, VGFX_RD_StaticBatchDesc *desc) {
+
+  VGFX_ASSERT_NON_NULL(pipeline);
+  VGFX_ASSERT_NON_NULL(desc);
+  VGFX_ASSERT_NON_ZERO(desc->capacity);
+  VGFX_ASSERT(pipeline->mode == VGFX_RD_PIPELINE_MODE_BATCH, 
+              "Static batches can only be created for batch pipelines.");
+
+  VGFX_RD_StaticBatch *batch = (VGFX_RD_StaticBatch *) calloc(1, sizeof(VGFX_RD_StaticBatch));
+
+  batch->pipeline       = pipeline;
+  batch->capacity       = desc->capacity;
+  batch->count          = 0;
+  batch->dirty_begin    = desc->capacity;
+  batch->dirty_end      = 0;
+  batch->texture_target = pipeline->texture_target;
+  batch->crn_texture    = 0;
+
+  // CPU copy of the quads, dirty ranges are uploaded from it
+  const usize size = desc->capacity * 4 * sizeof(VGFX_RD_Vertex);
+
+  batch->vertices = (VGFX_RD_Vertex *) malloc(size);
+  VGFX_ASSERT(batch->vertices, "Failed to allocate static batch.");
+
+  batch->vb = vgfx_gl_buffer_create(GL_ARRAY_BUFFER);
+  vgfx_gl_buffer_data(&batch->vb, GL_STATIC_DRAW, size, NULL);
+
+  // Shares the quad index buffer of all pipelines
+  VGFX_GL_VertexAttribLayout layout = _vgfx_rd_vertex_layout(VGFX_RD_PIPELINE_MODE_BATCH);
+  layout.buffer = batch->vb;
+
+  batch->va = vgfx_gl_vertex_array_create();
+  vgfx_gl_vertex_array_layout(&batch->va, &layout);
+  vgfx_gl_vertex_array_index_buffer(&batch->va, _vgfx_rd_quad_indices_acquire());
+
+  return batch;
+}
+
+void 
+vgfx_rd_static_batch_free(VGFX_RD_StaticBatch *batch) {
+
+  VGFX_ASSERT_NON_NULL(batch);
+
+  vgfx_gl_buffer_delete(&batch->vb);
+  vgfx_gl_vertex_array_delete(&batch->va);
+  _vgfx_rd_quad_indices_release();
+
+  free(batch->vertices);
+  free(batch);
+}
+
+usize 
+vgfx_rd_static_batch_add(VGFX_RD_StaticBatch *batch, VGFX_AS_Texture *handle, vec3 pos, 
+                         vec2 scl, f32 rot, vec4 tex, vec4 col) {
+
+  VGFX_ASSERT_NON_NULL(batch);
+  VGFX_ASSERT(batch->count < batch->capacity, "Static batch is out of capacity.");
+
+  usize index = batch->count;
+  batch->count += 1;
+
+  _vgfx_rd_static_batch_write(batch, index, handle, pos, scl, rot, tex, col);
+
+  return index;
+}
+
+void 
+vgfx_rd_static_batch_set(VGFX_RD_StaticBatch *batch, usize index, VGFX_AS_Texture *handle, 
+                         vec3 pos, vec2 scl, f32 rot, vec4 tex, vec4 col) {
+
+  VGFX_ASSERT_NON_NULL(batch);
+  VGFX_DEBUG_ASSERT(index < batch->count, "Invalid static batch index, `%lu`.", index);
+
+  _vgfx_rd_static_batch_write(batch, index, handle, pos, scl, rot, tex, col);
+}
+
+void 
+vgfx_rd_static_batch_clear(VGFX_RD_StaticBatch *batch) {
+
+  VGFX_ASSERT_NON_NULL(batch);
+
+  batch->count       = 0;
+  batch->dirty_begin = batch->capacity;
+  batch->dirty_end   = 0;
+  batch->crn_texture = 0;
+}
+
+void 
+vgfx_rd_static_batch_draw(VGFX_RD_StaticBatch *batch) {
+
+  VGFX_ASSERT_NON_NULL(batch);
+  VGFX_DEBUG_ASSERT(s_rd_bound_pipeline == batch->pipeline, 
+                    "Static batch must be drawn inside a pass of its pipeline.");
+
+  if (!batch->count) {
+    return;
+  }
+
+  VGFX_RD_Pipeline *pipeline = s_rd_bound_pipeline;
+
+  // Keep submission order, deferred quads are still drawn on flush
+  if (pipeline->sort.mode == VGFX_RD_SORT_MODE_NONE && pipeline->crn_vertex_count) {
+    _vgfx_rd_pipeline_internal_flush(VGFX_RD_FLUSH_CAUSE_ORDER);
+  }
+
+  // Upload modified quads only
+  if (batch->dirty_begin < batch->dirty_end) {
+    const usize offset = batch->dirty_begin * 4;
+    const usize count  = (batch->dirty_end - batch->dirty_begin) * 4;
+
+    vgfx_gl_buffer_sub_data(&batch->vb, offset * sizeof(VGFX_RD_Vertex), 
+                            count * sizeof(VGFX_RD_Vertex), &batch->vertices[offset]);
+
+    pipeline->stats.crn.bytes_streamed += count * sizeof(VGFX_RD_Vertex);
+
+    batch->dirty_begin = batch->capacity;
+    batch->dirty_end   = 0;
+  }
+
+  // Set textures, units match the ones the pipeline uses
+  for (usize i = 0; i < batch->crn_texture; ++i) {
+    vgfx_gl_bind_texture(batch->texture_target, batch->textures[i], i);
+  }
+
+  pipeline->stats.crn.texture_binds += batch->crn_texture;
+
+  if (pipeline->indirect.mode == VGFX_RD_SUBMIT_MODE_INDIRECT) {
+    vgfx_gl_uniform_set_iv(pipeline->_cache.texture_base, 1, (i32[1]){0});
+  }
+
+  vgfx_gl_bind_vertex_array(batch->va.handle);
+
+  pipeline->stats.crn.draws    += _vgfx_rd_draw_quads(0, batch->count);
+  pipeline->stats.crn.vertices += batch->count * 4;
+  pipeline->stats.crn.indices  += batch->count * 6;
+}
+
+void 
+_vgfx_rd_static_batch_write(VGFX_RD_StaticBatch *batch, usize index, VGFX_AS_Texture *handle, 
+                            const f32 *pos, const f32 *scl, f32 rot, const f32 *tex, 
+                            const f32 *col) {
+
+  const f32 *ttex  = (tex) ? tex : VGFX_RD_NO_SUB_TEXTURE;
+  const f32 *scale = (handle) ? handle->uv_scale : (f32[2]){1.0f, 1.0f};
+
+  const f32 stex[4] = {
+    ttex[0] * scale[0],
+    ttex[1] * scale[1],
+    ttex[2] * scale[0],
+    ttex[3] * scale[1],
+  };
+
+  const u8 pcol[4] = {
+    VGFX_RD_PACK_UNORM8(col[0]),
+    VGFX_RD_PACK_UNORM8(col[1]),
+    VGFX_RD_PACK_UNORM8(col[2]),
+    VGFX_RD_PACK_UNORM8(col[3]),
+  };
+
+  u8 slot = _vgfx_rd_static_batch_texture(batch, handle);
+
+  _vgfx_rd_build_quad(&batch->vertices[index * 4], slot, pos, scl, rot, stex, pcol);
+
+  // Grow the dirty range
+  if (index < batch->dirty_begin) {
+    batch->dirty_begin = index;
+  }
+
+  if (index + 1 > batch->dirty_end) {
+    batch->dirty_end = index + 1;
+  }
+}
+
+u8 
+_vgfx_rd_static_batch_texture(VGFX_RD_StaticBatch *batch, VGFX_AS_Texture *handle) {
+
+  if (!handle) {
+    return VGFX_RD_NO_TEXTURE;
+  }
+
+  VGFX_DEBUG_ASSERT(handle->target == batch->texture_target,
+                    "Texture target doesn't match the static batch.");
+
+  // Array batches sample a single array by layer
+  if (batch->texture_target == GL_TEXTURE_2D_ARRAY) {
+    VGFX_ASSERT(!batch->crn_texture || batch->textures[0] == handle->handle,
+                "Static batch can only sample a single texture array.");
+
+    batch->textures[0] = handle->handle;
+    batch->crn_texture = 1;
+
+    return (u8)handle->layer;
+  }
+
+  for (usize i = 0; i < batch->crn_texture; ++i) {
+    if (batch->textures[i] == handle->handle) {
+      return (u8)i;
+    }
+  }
+
+  VGFX_ASSERT(batch->crn_texture < VGFX_RD_MAX_BOUND_TEXTURE, 
+              "Static batch is out of texture slots.");
+
+  batch->textures[batch->crn_texture] = handle->handle;
+
+  return (u8)batch->crn_texture++;
 }
@@ -2,6 +2,7 @@
 
 #include "core.h"
 #include "asset.h"
+#include "camera.h"
 #include "gl.h"
 
 // =============================================
@@ -12,51 +13,344 @@
 //
 // =============================================
 
-#define VGFX_RD_MAX_BOUND_TEXTURE  16
+#define VGFX_RD_MAX_BOUND_TEXTURE    16
 
-#define VGFX_RD_MAX_QUAD_COUNT     15000
+#define VGFX_RD_DEFAULT_QUAD_COUNT   15000
 
-#define VGFX_RD_MAX_INDEX_COUNT    (VGFX_RD_MAX_QUAD_COUNT * 6)
+#define VGFX_RD_QUAD_INDEX_CHUNK     16384 // Quads addressable with 16-bit indices
 
-#define VGFX_RD_MAX_VERTEX_COUNT   (VGFX_RD_MAX_QUAD_COUNT * 4)
+#define VGFX_RD_STREAM_SEGMENT_COUNT 3
+
+#define VGFX_RD_TEXTURE_TABLE_SIZE   64
+
+#define VGFX_RD_NO_TEXTURE           0xFF
+
+#define VGFX_RD_MAX_INDIRECT_TEXTURE 32
+
+#define VGFX_RD_MAX_INDIRECT_DRAW    VGFX_RD_MAX_INDIRECT_TEXTURE // Array pages use one unit each
+
+#define VGFX_RD_MAX_PASS_COUNT       16
+
+#define VGFX_RD_PASS_NAME_SIZE       32
+
+#define VGFX_RD_QUERY_LATENCY        4
+
+#define VGFX_RD_CULL_BLOCK           256
+
+#define VGFX_RD_PACK_UNORM8(v)       ((u8)(glm_clamp_zo(v) * 255.0f + 0.5f))
+
+#define VGFX_RD_PACK_UNORM16(v)      ((u16)(glm_clamp_zo(v) * 65535.0f + 0.5f))
+
+typedef i32 VGFX_RD_StreamMode;
+enum VGFX_RD_StreamMode {
+  VGFX_RD_STREAM_MODE_SUB_DATA,
+  VGFX_RD_STREAM_MODE_ORPHAN,
+  VGFX_RD_STREAM_MODE_RING,
+};
+
+typedef i32 VGFX_RD_PipelineMode;
+enum VGFX_RD_PipelineMode {
+  VGFX_RD_PIPELINE_MODE_BATCH,
+  VGFX_RD_PIPELINE_MODE_INSTANCED,
+};
+
+typedef i32 VGFX_RD_SortMode;
+enum VGFX_RD_SortMode {
+  VGFX_RD_SORT_MODE_NONE,
+  VGFX_RD_SORT_MODE_DEFERRED,
+  VGFX_RD_SORT_MODE_STABLE,
+  VGFX_RD_SORT_MODE_DEPTH,   // Opaque front-to-back by z, then translucent by layer and back-to-front
+};
+
+typedef i32 VGFX_RD_SubmitMode;
+enum VGFX_RD_SubmitMode {
+  VGFX_RD_SUBMIT_MODE_DIRECT,
+  VGFX_RD_SUBMIT_MODE_INDIRECT,
+};
+
+typedef i32 VGFX_RD_FlushCause;
+enum VGFX_RD_FlushCause {
+  VGFX_RD_FLUSH_CAUSE_CAPACITY,
+  VGFX_RD_FLUSH_CAUSE_TEXTURE,
+  VGFX_RD_FLUSH_CAUSE_ORDER,
+};
+
+typedef i32 VGFX_RD_StatsScope;
+enum VGFX_RD_StatsScope {
+  VGFX_RD_STATS_SCOPE_FRAME,
+  VGFX_RD_STATS_SCOPE_TOTAL,
+};
+
+typedef struct VGFX_RD_Stats VGFX_RD_Stats;
+struct VGFX_RD_Stats {
+  usize frames;
+  usize draws;
+  usize vertices;
+  usize indices;
+  usize instances;
+  usize bytes_streamed;
+  usize texture_binds;
+  usize flush_user;
+  usize flush_capacity;
+  usize flush_texture;
+  usize flush_order;
+  usize culled;
+};
+
+typedef struct VGFX_RD_PassStats VGFX_RD_PassStats;
+struct VGFX_RD_PassStats {
+  char  name[VGFX_RD_PASS_NAME_SIZE];
+  f64   cpu_time;   // Milliseconds from begin to flush
+  f64   gpu_time;   // Milliseconds, resolved a few frames late
+  u64   primitives;
+  u64   fragments;
+  usize samples;
+  usize dropped;
+};
+
+typedef struct _VGFX_RD_PassQueries _VGFX_RD_PassQueries;
+struct _VGFX_RD_PassQueries {
+  VGFX_GL_Query time[VGFX_RD_QUERY_LATENCY];
+  VGFX_GL_Query primitives[VGFX_RD_QUERY_LATENCY];
+  VGFX_GL_Query fragments[VGFX_RD_QUERY_LATENCY];
+  usize         head;
+  usize         tail;
+};
+
+#define VGFX_RD_SORT_KEY(layer, texture) (((u64)(layer) << 48) | (u64)(texture))
+
+typedef struct VGFX_RD_PipelineDesc VGFX_RD_PipelineDesc;
+struct VGFX_RD_PipelineDesc {
+  VGFX_RD_PipelineMode mode;
+  VGFX_RD_StreamMode   stream_mode;
+  VGFX_RD_SortMode     sort_mode;
+  VGFX_RD_SubmitMode   submit_mode;
+  bool                 texture_array; // Indirect draws each sample one page
+  bool                 gpu_timing;
+  usize                capacity; // Quads, zero picks the default
+};
+
+typedef struct VGFX_RD_Vertex VGFX_RD_Vertex;
+struct VGFX_RD_Vertex {
+  f32 pos[3];
+  u16 tex[2];
+  u8  col[4];
+  u8  texture;
+};
+
+typedef struct VGFX_RD_Instance VGFX_RD_Instance;
+struct VGFX_RD_Instance {
+  f32 pos[3];
+  f32 size[2];
+  f32 rot;
+  u16 tex[4];
+  u8  col[4];
+  u8  texture;
+};
+
+typedef struct VGFX_RD_Command VGFX_RD_Command;
+struct VGFX_RD_Command {
+  VGFX_AS_TextureHandle texture;
+  u32                   layer;
+  u16                   sort_layer;
+  f32                   pos[3];
+  f32                   scl[2];
+  f32                   rot;
+  f32                   tex[4];
+  u8                    col[4];
+  bool                  opaque;
+};
+
+typedef struct VGFX_RD_SortItem VGFX_RD_SortItem;
+struct VGFX_RD_SortItem {
+  u64 key;
+  u32 index;
+};
+
+typedef struct VGFX_RD_Sprite VGFX_RD_Sprite;
+struct VGFX_RD_Sprite {
+  vec3 pos;
+  vec2 scl;
+  vec4 tex;
+  vec4 col;
+};
+
+typedef struct _VGFX_RD_TextureEntry _VGFX_RD_TextureEntry;
+struct _VGFX_RD_TextureEntry {
+  VGFX_AS_TextureHandle texture;
+  u32                   stamp;
+  u8                    slot;
+};
 
 typedef struct VGFX_RD_Pipeline VGFX_RD_Pipeline;
 struct VGFX_RD_Pipeline {
   struct {
     VGFX_AS_TextureHandle     texture;
+    u8                        slot;
     bool                      internal_flush;
+    u32                       stamp;
+    const VGFX_AS_Uniform    *texture_base;
+    _VGFX_RD_TextureEntry     slots[VGFX_RD_TEXTURE_TABLE_SIZE];
   }                           _cache;
-  VGFX_GL_Buffer              vb;
-  VGFX_GL_Buffer              ib;
-  VGFX_GL_VertexArray         va;
+  struct {
+    VGFX_RD_StreamMode        mode;
+    bool                      persistent;
+    usize                     stride;
+    usize                     capacity;
+    usize                     segment;
+    usize                     segment_count;
+    void                     *mapped[VGFX_RD_STREAM_SEGMENT_COUNT];
+    VGFX_GL_Fence             fences[VGFX_RD_STREAM_SEGMENT_COUNT];
+    usize                     fence_checks;
+    usize                     fence_waits;
+  }                           stream;
+  struct {
+    VGFX_RD_SortMode          mode;
+    u16                       layer;
+    VSTD_Vector(VGFX_RD_Command)  commands;
+    VSTD_Vector(VGFX_RD_SortItem) items;
+    VGFX_RD_SortItem         *_scratch;
+    usize                     _scratch_cap;
+    VGFX_AS_TextureHandle     _sim_textures[VGFX_RD_MAX_BOUND_TEXTURE];
+    usize                     _sim_texture_count;
+    usize                     _sim_quad_count;
+    usize                     draws;
+    usize                     draws_unsorted;
+    VGFX_AS_Shader           *shader;
+    VGFX_AS_Shader           *opaque_shader;
+    VGFX_GL_UniformLink      *_links;          // sort.shader to opaque_shader
+    usize                     _link_count;
+    u32                       _link_src;
+    u32                       _link_dst;
+  }                           sort;
+  struct {
+    VGFX_RD_SubmitMode        mode;
+    VGFX_GL_Buffer            buffer;
+    VGFX_GL_DrawElementsIndirectCommand draws[VGFX_RD_MAX_INDIRECT_DRAW];
+    i32                       bases[VGFX_RD_MAX_INDIRECT_DRAW];
+    usize                     draw_count;
+    usize                     first_index;
+    usize                     max_texture;
+    usize                     window;           // Texture units a single draw can use
+    usize                     crn_texture;
+    VGFX_AS_TextureHandle     textures[VGFX_RD_MAX_INDIRECT_TEXTURE];
+  }                           indirect;
+  struct {
+    VGFX_RD_Stats             crn;
+    VGFX_RD_Stats             frame;
+    VGFX_RD_Stats             total;
+  }                           stats;
+  struct {
+    bool                      enabled;
+    bool                      statistics;
+    usize                     count;
+    VGFX_RD_PassStats         stats[VGFX_RD_MAX_PASS_COUNT];
+    _VGFX_RD_PassQueries      queries[VGFX_RD_MAX_PASS_COUNT];
+    isize                     active;
+    f64                       start;
+  }                           passes;
+  struct {
+    bool                      enabled;
+    vec4                      planes[6];
+  }                           cull;
+  VGFX_RD_PipelineMode        mode;
+  VGFX_GL_Buffer              vb[VGFX_RD_STREAM_SEGMENT_COUNT];
+  VGFX_GL_VertexArray         va[VGFX_RD_STREAM_SEGMENT_COUNT];
   usize                       max_vertex_count;
   usize                       crn_vertex_count;
-  VSTD_Vector(VGFX_RD_Vertex) cpu_vb;
+  usize                       max_instance_count;
+  usize                       crn_instance_count;
+  VSTD_Vector(u8)             cpu_vb;
+  union {
+    VGFX_RD_Vertex           *vertices;
+    VGFX_RD_Instance         *instances;
+  };
   usize                       crn_index_count;
   usize                       crn_texture;
+  u32                         texture_target;
   VGFX_AS_TextureHandle       textures[VGFX_RD_MAX_BOUND_TEXTURE];
 };
 
-typedef struct VGFX_RD_Vertex VGFX_RD_Vertex;
-struct VGFX_RD_Vertex {
-  f32 texture;
-  f32 pos[3];
-  f32 tex[2];
-  f32 col[4];
-};
-
+// Array pipelines only sample array pages, font atlases need a 2D pipeline
 VGFX_RD_Pipeline *
-vgfx_rd_pipeline_new(VGFX_AS_AssetServer *as);
+vgfx_rd_pipeline_new(VGFX_AS_AssetServer *as, VGFX_RD_PipelineDesc *desc);
 
 void 
 vgfx_rd_piepline_free(VGFX_RD_Pipeline *pipeline);
 
 void 
-vgfx_rd_pipeline_begin(VGFX_RD_Pipeline *pipeline, VGFX_AS_Asset *shader);
+vgfx_rd_pipeline_begin(VGFX_RD_Pipeline *pipeline, VGFX_AS_Shader *shader);
+
+void 
+vgfx_rd_pipeline_begin_pass(VGFX_RD_Pipeline *pipeline, VGFX_AS_Shader *shader, 
+                            const char *name);
 
 void 
 vgfx_rd_pipeline_flush();
 
+void 
+vgfx_rd_pipeline_end_frame(VGFX_RD_Pipeline *pipeline);
+
+const VGFX_RD_Stats *
+vgfx_rd_pipeline_stats(VGFX_RD_Pipeline *pipeline, VGFX_RD_StatsScope scope);
+
+const VGFX_RD_PassStats *
+vgfx_rd_pipeline_pass_stats(VGFX_RD_Pipeline *pipeline, usize *count);
+
+VGFX_GL_VertexAttribLayout 
+_vgfx_rd_vertex_layout(VGFX_RD_PipelineMode mode);
+
+void 
+_vgfx_rd_pipeline_stream_map(VGFX_RD_Pipeline *pipeline);
+
+void 
+_vgfx_rd_pipeline_stream_unmap(VGFX_RD_Pipeline *pipeline);
+
+void 
+_vgfx_rd_pipeline_internal_flush(VGFX_RD_FlushCause cause);
+
+void 
+_vgfx_rd_pipeline_reset_textures(VGFX_RD_Pipeline *pipeline);
+
+void 
+_vgfx_rd_pipeline_pass_begin(VGFX_RD_Pipeline *pipeline, const char *name);
+
+void 
+_vgfx_rd_pipeline_pass_end(VGFX_RD_Pipeline *pipeline);
+
+void 
+_vgfx_rd_pipeline_pass_resolve(VGFX_RD_Pipeline *pipeline, usize index);
+
+bool 
+_vgfx_rd_pipeline_split();
+
+void 
+_vgfx_rd_pipeline_close_draw(VGFX_RD_Pipeline *pipeline);
+
+VGFX_GL_Buffer *
+_vgfx_rd_quad_indices_acquire();
+
+void 
+_vgfx_rd_quad_indices_release();
+
+usize 
+_vgfx_rd_draw_quads(usize first, usize count);
+
+usize 
+_vgfx_rd_pipeline_reserve(usize count);
+
+void 
+_vgfx_rd_pipeline_replay(VGFX_RD_Pipeline *pipeline);
+
+VGFX_RD_SortItem *
+_vgfx_rd_radix_sort(VGFX_RD_SortItem *items, VGFX_RD_SortItem *scratch, usize count);
+
+u64 
+_vgfx_rd_depth_key(f32 depth, bool opaque, u16 layer, VGFX_AS_TextureHandle texture);
+
+void 
+_vgfx_rd_pipeline_blend(VGFX_RD_Pipeline *pipeline, bool opaque);
+
 // =============================================
 //
 //
@@ -77,17 +371,257 @@ vgfx_rd_pipeline_flush();
   }
 #endif
 
+typedef struct VGFX_RD_QuadArrays VGFX_RD_QuadArrays;
+struct VGFX_RD_QuadArrays {
+  const f32 *x;
+  const f32 *y;
+  const f32 *z;
+  const f32 *w;
+  const f32 *h;
+  const f32 *tex_x;  // NULL for the whole texture
+  const f32 *tex_y;
+  const f32 *tex_w;
+  const f32 *tex_h;
+  const u32 *col;    // RGBA8, NULL for white
+  usize      stride; // Bytes between elements, zero for packed arrays
+};
+
+void 
+vgfx_rd_set_layer(u16 layer);
+
+void 
+vgfx_rd_set_camera(VGFX_RD_Camera *camera);
+
+void 
+vgfx_rd_set_opaque_shader(VGFX_AS_Shader *shader);
+
 void 
 vgfx_rd_send_vert(f32 texture, vec3 pos, vec2 tex, vec4 col);
 
 void 
 vgfx_rd_send_quad(f32 texture, vec3 pos, vec2 scl, vec4 tex, vec4 col);
 
+void 
+vgfx_rd_send_quad_rotated(f32 texture, vec3 pos, vec2 scl, f32 rot, vec4 tex, vec4 col);
+
 void 
 vgfx_rd_send_texture(VGFX_AS_Texture *handle, vec3 pos, vec2 scl, vec4 tex, vec4 col);
 
+void 
+vgfx_rd_send_texture_rotated(VGFX_AS_Texture *handle, vec3 pos, vec2 scl, f32 rot, 
+                             vec4 tex, vec4 col);
+
+void 
+vgfx_rd_send_texture_batch(VGFX_AS_Texture *handle, VGFX_RD_Sprite *sprites, usize count);
+
+void 
+vgfx_rd_send_quads(VGFX_AS_Texture *handle, const VGFX_RD_QuadArrays *quads, usize count);
+
 void 
 vgfx_rd_send_text(VGFX_AS_Font *handle, const char* str, vec3 pos, vec4 col);
 
+void 
+vgfx_rd_send_stats(VGFX_AS_Font *handle, const VGFX_RD_Stats *stats, vec3 pos, vec4 col);
+
 vec2s 
 vgfx_rd_font_render_size(VGFX_AS_Font *handle, const char *str, bool fh);
+
+void 
+_vgfx_rd_write_quad(u8 texture, const f32 *pos, const f32 *scl, f32 rot, 
+                    const f32 *tex, const u8 *col);
+
+void 
+_vgfx_rd_build_quad(VGFX_RD_Vertex *v, u8 texture, const f32 *pos, const f32 *scl, 
+                    f32 rot, const f32 *tex, const u8 *col);
+
+void 
+_vgfx_rd_quad_arrays_fetch(const VGFX_RD_QuadArrays *quads, usize index, const f32 *uv_scale, 
+                           f32 *pos, f32 *scl, f32 *tex, u8 *col);
+
+void 
+_vgfx_rd_record_quad(VGFX_AS_TextureHandle texture, u32 layer, bool opaque, const f32 *pos, 
+                     const f32 *scl, f32 rot, const f32 *tex, const u8 *col);
+
+bool 
+_vgfx_rd_cull_quad(const f32 *pos, const f32 *scl, f32 rot);
+
+usize 
+_vgfx_rd_cull_batch(const VGFX_RD_QuadArrays *quads, usize first, usize count, u8 *visible);
+
+void 
+_vgfx_rd_expand_range(VGFX_AS_TextureHandle texture, u32 layer, const f32 *uv_scale, 
+                      const VGFX_RD_QuadArrays *quads, usize first, usize count);
+
+u8 
+_vgfx_rd_texture_resolve(VGFX_AS_TextureHandle texture, u32 layer);
+
+u8 
+_vgfx_rd_texture_slot(VGFX_AS_TextureHandle texture);
+
+u8
+_vgfx_rd_texture_layer(VGFX_AS_TextureHandle array, u32 layer);
+
+// =============================================
+//
+//
+// SIMD
+//
+//
+// =============================================
+
+typedef i32 VGFX_RD_SimdIsa;
+enum VGFX_RD_SimdIsa {
+  VGFX_RD_SIMD_ISA_SCALAR,
+  VGFX_RD_SIMD_ISA_SSE2,
+  VGFX_RD_SIMD_ISA_AVX2,
+  VGFX_RD_SIMD_ISA_NEON,
+};
+
+typedef void (*_VGFX_RD_QuadKernel)(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, 
+                                    usize first, usize count, u8 texture, 
+                                    const f32 *uv_scale);
+
+typedef usize (*_VGFX_RD_CullKernel)(const VGFX_RD_QuadArrays *quads, usize first, 
+                                     usize count, vec4 *planes, u8 *visible);
+
+bool 
+vgfx_rd_simd_isa_supported(VGFX_RD_SimdIsa isa);
+
+void 
+vgfx_rd_simd_isa_set(VGFX_RD_SimdIsa isa);
+
+VGFX_RD_SimdIsa 
+vgfx_rd_simd_isa_get();
+
+const char *
+vgfx_rd_simd_isa_name(VGFX_RD_SimdIsa isa);
+
+void 
+_vgfx_rd_expand_quads(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first, 
+                      usize count, u8 texture, const f32 *uv_scale);
+
+void 
+_vgfx_rd_expand_quads_scalar(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first, 
+                             usize count, u8 texture, const f32 *uv_scale);
+
+void 
+_vgfx_rd_expand_quads_sse2(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first, 
+                           usize count, u8 texture, const f32 *uv_scale);
+
+void 
+_vgfx_rd_expand_quads_avx2(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first, 
+                           usize count, u8 texture, const f32 *uv_scale);
+
+void 
+_vgfx_rd_expand_quads_neon(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first, 
+                           usize count, u8 texture, const f32 *uv_scale);
+
+usize 
+_vgfx_rd_cull_quads(const VGFX_RD_QuadArrays *quads, usize first, usize count, vec4 *planes, 
+                    u8 *visible);
+
+usize 
+_vgfx_rd_cull_quads_scalar(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                           vec4 *planes, u8 *visible);
+
+usize 
+_vgfx_rd_cull_quads_sse2(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                         vec4 *planes, u8 *visible);
+
+usize 
+_vgfx_rd_cull_quads_avx2(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                         vec4 *planes, u8 *visible);
+
+usize 
+_vgfx_rd_cull_quads_neon(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                         vec4 *planes, u8 *visible);
+
+// =============================================
+//
+//
+// Recorder
+//
+//
+// =============================================
+
+typedef struct VGFX_RD_Recorder VGFX_RD_Recorder;
+struct VGFX_RD_Recorder {
+  VSTD_Vector(VGFX_RD_Command) commands;
+  u16                          layer;
+};
+
+VGFX_RD_Recorder *
+vgfx_rd_recorder_new();
+
+void 
+vgfx_rd_recorder_free(VGFX_RD_Recorder *recorder);
+
+void 
+vgfx_rd_recorder_begin(VGFX_RD_Recorder *recorder);
+
+void 
+vgfx_rd_recorder_end();
+
+void 
+vgfx_rd_pipeline_merge(VGFX_RD_Recorder **recorders, usize count);
+
+void 
+_vgfx_rd_recorder_push(VGFX_RD_Recorder *recorder, VGFX_AS_TextureHandle texture, u32 layer, 
+                       bool opaque, const f32 *pos, const f32 *scl, f32 rot, const f32 *tex, 
+                       const u8 *col);
+
+// =============================================
+//
+//
+// Static Batch
+//
+//
+// =============================================
+
+typedef struct VGFX_RD_StaticBatchDesc VGFX_RD_StaticBatchDesc;
+struct VGFX_RD_StaticBatchDesc {
+  usize capacity;
+};
+
+typedef struct VGFX_RD_StaticBatch VGFX_RD_StaticBatch;
+struct VGFX_RD_StaticBatch {
+  VGFX_RD_Pipeline           *pipeline;
+  VGFX_GL_Buffer              vb;
+  VGFX_GL_VertexArray         va;
+  VGFX_RD_Vertex             *vertices;
+  usize                       capacity;
+  usize                       count;
+  usize                       dirty_begin;
+  usize                       dirty_end;
+  u32                         texture_target;
+  usize                       crn_texture;
+  VGFX_AS_TextureHandle       textures[VGFX_RD_MAX_BOUND_TEXTURE];
+};
+
+VGFX_RD_StaticBatch *
+vgfx_rd_static_batch_new(VGFX_RD_Pipeline *pipeline, VGFX_RD_StaticBatchDesc *desc);
+
+void 
+vgfx_rd_static_batch_free(VGFX_RD_StaticBatch *batch);
+
+usize 
+vgfx_rd_static_batch_add(VGFX_RD_StaticBatch *batch, VGFX_AS_Texture *handle, vec3 pos, 
+                         vec2 scl, f32 rot, vec4 tex, vec4 col);
+
+void 
+vgfx_rd_static_batch_set(VGFX_RD_StaticBatch *batch, usize index, VGFX_AS_Texture *handle, 
+                         vec3 pos, vec2 scl, f32 rot, vec4 tex, vec4 col);
+
+void 
+vgfx_rd_static_batch_clear(VGFX_RD_StaticBatch *batch);
+
+void 
+vgfx_rd_static_batch_draw(VGFX_RD_StaticBatch *batch);
+
+void 
+_vgfx_rd_static_batch_write(VGFX_RD_StaticBatch *batch, usize index, VGFX_AS_Texture *handle, 
+                            const f32 *pos, const f32 *scl, f32 rot, const f32 *tex, 
+                            const f32 *col);
+
+u8 
+_vgfx_rd_static_batch_texture(VGFX_RD_StaticBatch *batch, VGFX_AS_Texture *handle);
@@ -0,0 +1,708 @@
+#include "render.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VGFX_RD_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define VGFX_RD_SIMD_X86 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__aarch64__)
+#define VGFX_RD_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define VGFX_RD_SIMD_NEON 0
+#endif
+
+static VGFX_RD_SimdIsa     s_rd_simd_isa    = VGFX_RD_SIMD_ISA_SCALAR;
+
+static _VGFX_RD_QuadKernel s_rd_quad_kernel = NULL;
+
+static _VGFX_RD_CullKernel s_rd_cull_kernel = NULL;
+
+// Element of a quad array field, both `f32` and `u32` fields are four bytes wide
+#define _VGFX_RD_QUAD_FIELD(quads, field, i)                                   \
+  ((const void *)((const u8 *)(quads)->field +                                 \
+                  (i) * (((quads)->stride) ? (quads)->stride : sizeof(f32))))
+
+// =============================================
+//
+//
+// Dispatch
+//
+//
+// =============================================
+
+bool
+vgfx_rd_simd_isa_supported(VGFX_RD_SimdIsa isa) {
+
+  switch (isa) {
+  case VGFX_RD_SIMD_ISA_SCALAR:
+    return true;
+#if VGFX_RD_SIMD_X86
+  case VGFX_RD_SIMD_ISA_SSE2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+  case VGFX_RD_SIMD_ISA_AVX2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+#if VGFX_RD_SIMD_NEON
+  case VGFX_RD_SIMD_ISA_NEON:
+    return true;
+#endif
+  default:
+    return false;
+  }
+}
+
+void
+vgfx_rd_simd_isa_set(VGFX_RD_SimdIsa isa) {
+
+  VGFX_ASSERT(vgfx_rd_simd_isa_supported(isa),
+              "Instruction set isn't supported, `%s`.", vgfx_rd_simd_isa_name(isa));
+
+  switch (isa) {
+  case VGFX_RD_SIMD_ISA_SSE2:
+    s_rd_quad_kernel = _vgfx_rd_expand_quads_sse2;
+    s_rd_cull_kernel = _vgfx_rd_cull_quads_sse2;
+    break;
+  case VGFX_RD_SIMD_ISA_AVX2:
+    s_rd_quad_kernel = _vgfx_rd_expand_quads_avx2;
+    s_rd_cull_kernel = _vgfx_rd_cull_quads_avx2;
+    break;
+  case VGFX_RD_SIMD_ISA_NEON:
+    s_rd_quad_kernel = _vgfx_rd_expand_quads_neon;
+    s_rd_cull_kernel = _vgfx_rd_cull_quads_neon;
+    break;
+  default:
+    s_rd_quad_kernel = _vgfx_rd_expand_quads_scalar;
+    s_rd_cull_kernel = _vgfx_rd_cull_quads_scalar;
+    break;
+  }
+
+  s_rd_simd_isa = isa;
+}
+
+VGFX_RD_SimdIsa
+vgfx_rd_simd_isa_get() {
+
+  // Pick the widest supported kernel on first use
+  if (!s_rd_quad_kernel) {
+    const VGFX_RD_SimdIsa order[] = {
+      VGFX_RD_SIMD_ISA_AVX2,
+      VGFX_RD_SIMD_ISA_SSE2,
+      VGFX_RD_SIMD_ISA_NEON,
+      VGFX_RD_SIMD_ISA_SCALAR,
+    };
+
+    for (usize i = 0; i < sizeof(order) / sizeof(order[0]) && !s_rd_quad_kernel; ++i) {
+      if (vgfx_rd_simd_isa_supported(order[i])) {
+        vgfx_rd_simd_isa_set(order[i]);
+      }
+    }
+  }
+
+  return s_rd_simd_isa;
+}
+
+const char *
+vgfx_rd_simd_isa_name(VGFX_RD_SimdIsa isa) {
+
+  switch (isa) {
+  case VGFX_RD_SIMD_ISA_SCALAR:
+    return "scalar";
+  case VGFX_RD_SIMD_ISA_SSE2:
+    return "sse2";
+  case VGFX_RD_SIMD_ISA_AVX2:
+    return "avx2";
+  case VGFX_RD_SIMD_ISA_NEON:
+    return "neon";
+  default:
+    return "unknown";
+  }
+}
+
+void
+_vgfx_rd_expand_quads(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first,
+                      usize count, u8 texture, const f32 *uv_scale) {
+
+  vgfx_rd_simd_isa_get();
+
+  s_rd_quad_kernel(v, quads, first, count, texture, uv_scale);
+}
+
+// =============================================
+//
+//
+// Kernels
+//
+//
+// =============================================
+
+void
+_vgfx_rd_expand_quads_scalar(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first,
+                             usize count, u8 texture, const f32 *uv_scale) {
+
+  for (usize i = first; i < first + count; ++i, v += 4) {
+    f32 pos[3], scl[2], tex[4];
+    u8  col[4];
+    _vgfx_rd_quad_arrays_fetch(quads, i, uv_scale, pos, scl, tex, col);
+
+    _vgfx_rd_build_quad(v, texture, pos, scl, 0.0f, tex, col);
+  }
+}
+
+// Vectorized kernels compute positions and packed UVs for several quads at once.
+// Each vertex is then written as one 16 byte store of `pos` and `tex`, followed by
+// the color and texture slot. Tails are finished by the scalar kernel.
+
+#if VGFX_RD_SIMD_X86
+
+static inline __m128
+_vgfx_rd_sse2_load(const VGFX_RD_QuadArrays *quads, const f32 *field, usize i) {
+
+  if (!quads->stride) {
+    return _mm_loadu_ps(&field[i]);
+  }
+
+  const u8 *ptr = (const u8 *)field + i * quads->stride;
+
+  return _mm_setr_ps(*(const f32 *)(ptr),
+                     *(const f32 *)(ptr + quads->stride),
+                     *(const f32 *)(ptr + quads->stride * 2),
+                     *(const f32 *)(ptr + quads->stride * 3));
+}
+
+static inline __m128i
+_vgfx_rd_sse2_unorm16(__m128 v) {
+
+  v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+
+  return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(65535.0f)), _mm_set1_ps(0.5f)));
+}
+
+static inline void
+_vgfx_rd_sse2_store(VGFX_RD_Vertex *v, __m128 px[4], __m128 py[4], __m128 pz, __m128 uv[4],
+                    const u32 *col, u8 texture) {
+
+  // Corner `c` of quad `q` is vertex `q * 4 + c`
+  for (usize c = 0; c < 4; ++c) {
+    __m128 r0 = px[c];
+    __m128 r1 = py[c];
+    __m128 r2 = pz;
+    __m128 r3 = uv[c];
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    _mm_storeu_ps((f32 *)&v[0 * 4 + c], r0);
+    _mm_storeu_ps((f32 *)&v[1 * 4 + c], r1);
+    _mm_storeu_ps((f32 *)&v[2 * 4 + c], r2);
+    _mm_storeu_ps((f32 *)&v[3 * 4 + c], r3);
+  }
+
+  for (usize q = 0; q < 4; ++q) {
+    for (usize c = 0; c < 4; ++c) {
+      memcpy(v[q * 4 + c].col, &col[q], sizeof(u32));
+      v[q * 4 + c].texture = texture;
+    }
+  }
+}
+
+void
+_vgfx_rd_expand_quads_sse2(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first,
+                           usize count, u8 texture, const f32 *uv_scale) {
+
+  const usize end = first + count;
+
+  const __m128 su = _mm_set1_ps(uv_scale[0]);
+  const __m128 sv = _mm_set1_ps(uv_scale[1]);
+
+  usize i = first;
+  for (; i + 4 <= end; i += 4, v += 16) {
+    __m128 x0 = _vgfx_rd_sse2_load(quads, quads->x, i);
+    __m128 y0 = _vgfx_rd_sse2_load(quads, quads->y, i);
+    __m128 z  = _vgfx_rd_sse2_load(quads, quads->z, i);
+    __m128 x1 = _mm_add_ps(x0, _vgfx_rd_sse2_load(quads, quads->w, i));
+    __m128 y1 = _mm_add_ps(y0, _vgfx_rd_sse2_load(quads, quads->h, i));
+
+    __m128 tx = _mm_setzero_ps();
+    __m128 ty = _mm_setzero_ps();
+    __m128 tw = su;
+    __m128 th = sv;
+
+    if (quads->tex_x) {
+      tx = _mm_mul_ps(_vgfx_rd_sse2_load(quads, quads->tex_x, i), su);
+      ty = _mm_mul_ps(_vgfx_rd_sse2_load(quads, quads->tex_y, i), sv);
+      tw = _mm_mul_ps(_vgfx_rd_sse2_load(quads, quads->tex_w, i), su);
+      th = _mm_mul_ps(_vgfx_rd_sse2_load(quads, quads->tex_h, i), sv);
+    }
+
+    // UVs are flipped vertically, `u | v << 16` matches the `u16[2]` layout
+    __m128i u0 = _vgfx_rd_sse2_unorm16(tx);
+    __m128i u1 = _vgfx_rd_sse2_unorm16(_mm_add_ps(tx, tw));
+    __m128i vb = _mm_slli_epi32(_vgfx_rd_sse2_unorm16(_mm_add_ps(ty, th)), 16);
+    __m128i vt = _mm_slli_epi32(_vgfx_rd_sse2_unorm16(ty), 16);
+
+    __m128 px[4] = {x0, x1, x0, x1};
+    __m128 py[4] = {y0, y0, y1, y1};
+    __m128 uv[4] = {
+      _mm_castsi128_ps(_mm_or_si128(u0, vb)),
+      _mm_castsi128_ps(_mm_or_si128(u1, vb)),
+      _mm_castsi128_ps(_mm_or_si128(u0, vt)),
+      _mm_castsi128_ps(_mm_or_si128(u1, vt)),
+    };
+
+    u32 col[4] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
+    for (usize q = 0; q < 4 && quads->col; ++q) {
+      memcpy(&col[q], _VGFX_RD_QUAD_FIELD(quads, col, i + q), sizeof(u32));
+    }
+
+    _vgfx_rd_sse2_store(v, px, py, z, uv, col, texture);
+  }
+
+  _vgfx_rd_expand_quads_scalar(v, quads, i, end - i, texture, uv_scale);
+}
+
+__attribute__((target("avx2"))) static inline __m256
+_vgfx_rd_avx2_load(const VGFX_RD_QuadArrays *quads, const f32 *field, usize i) {
+
+  if (!quads->stride) {
+    return _mm256_loadu_ps(&field[i]);
+  }
+
+  const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                           _mm256_set1_epi32((i32)quads->stride));
+
+  return _mm256_i32gather_ps((const f32 *)((const u8 *)field + i * quads->stride), index, 1);
+}
+
+__attribute__((target("avx2"))) static inline __m256i
+_vgfx_rd_avx2_unorm16(__m256 v) {
+
+  v = _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+
+  return _mm256_cvttps_epi32(
+    _mm256_add_ps(_mm256_mul_ps(v, _mm256_set1_ps(65535.0f)), _mm256_set1_ps(0.5f)));
+}
+
+__attribute__((target("avx2"))) void
+_vgfx_rd_expand_quads_avx2(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first,
+                           usize count, u8 texture, const f32 *uv_scale) {
+
+  const usize end = first + count;
+
+  const __m256 su = _mm256_set1_ps(uv_scale[0]);
+  const __m256 sv = _mm256_set1_ps(uv_scale[1]);
+
+  usize i = first;
+  for (; i + 8 <= end; i += 8, v += 32) {
+    __m256 x0 = _vgfx_rd_avx2_load(quads, quads->x, i);
+    __m256 y0 = _vgfx_rd_avx2_load(quads, quads->y, i);
+    __m256 z  = _vgfx_rd_avx2_load(quads, quads->z, i);
+    __m256 x1 = _mm256_add_ps(x0, _vgfx_rd_avx2_load(quads, quads->w, i));
+    __m256 y1 = _mm256_add_ps(y0, _vgfx_rd_avx2_load(quads, quads->h, i));
+
+    __m256 tx = _mm256_setzero_ps();
+    __m256 ty = _mm256_setzero_ps();
+    __m256 tw = su;
+    __m256 th = sv;
+
+    if (quads->tex_x) {
+      tx = _mm256_mul_ps(_vgfx_rd_avx2_load(quads, quads->tex_x, i), su);
+      ty = _mm256_mul_ps(_vgfx_rd_avx2_load(quads, quads->tex_y, i), sv);
+      tw = _mm256_mul_ps(_vgfx_rd_avx2_load(quads, quads->tex_w, i), su);
+      th = _mm256_mul_ps(_vgfx_rd_avx2_load(quads, quads->tex_h, i), sv);
+    }
+
+    __m256i u0 = _vgfx_rd_avx2_unorm16(tx);
+    __m256i u1 = _vgfx_rd_avx2_unorm16(_mm256_add_ps(tx, tw));
+    __m256i vb = _mm256_slli_epi32(_vgfx_rd_avx2_unorm16(_mm256_add_ps(ty, th)), 16);
+    __m256i vt = _mm256_slli_epi32(_vgfx_rd_avx2_unorm16(ty), 16);
+
+    __m256 px[4] = {x0, x1, x0, x1};
+    __m256 py[4] = {y0, y0, y1, y1};
+    __m256 uv[4] = {
+      _mm256_castsi256_ps(_mm256_or_si256(u0, vb)),
+      _mm256_castsi256_ps(_mm256_or_si256(u1, vb)),
+      _mm256_castsi256_ps(_mm256_or_si256(u0, vt)),
+      _mm256_castsi256_ps(_mm256_or_si256(u1, vt)),
+    };
+
+    u32 col[8] = {
+      0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+      0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    };
+    for (usize q = 0; q < 8 && quads->col; ++q) {
+      memcpy(&col[q], _VGFX_RD_QUAD_FIELD(quads, col, i + q), sizeof(u32));
+    }
+
+    // Interleave each 128 bit half with the SSE store
+    for (usize h = 0; h < 2; ++h) {
+      __m128 hx[4], hy[4], huv[4];
+
+      for (usize c = 0; c < 4; ++c) {
+        hx[c]  = (h) ? _mm256_extractf128_ps(px[c], 1) : _mm256_castps256_ps128(px[c]);
+        hy[c]  = (h) ? _mm256_extractf128_ps(py[c], 1) : _mm256_castps256_ps128(py[c]);
+        huv[c] = (h) ? _mm256_extractf128_ps(uv[c], 1) : _mm256_castps256_ps128(uv[c]);
+      }
+
+      __m128 hz = (h) ? _mm256_extractf128_ps(z, 1) : _mm256_castps256_ps128(z);
+
+      _vgfx_rd_sse2_store(&v[h * 16], hx, hy, hz, huv, &col[h * 4], texture);
+    }
+  }
+
+  _vgfx_rd_expand_quads_scalar(v, quads, i, end - i, texture, uv_scale);
+}
+
+#else
+
+void
+_vgfx_rd_expand_quads_sse2(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first,
+                           usize count, u8 texture, const f32 *uv_scale) {
+
+  _vgfx_rd_expand_quads_scalar(v, quads, first, count, texture, uv_scale);
+}
+
+void
+_vgfx_rd_expand_quads_avx2(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first,
+                           usize count, u8 texture, const f32 *uv_scale) {
+
+  _vgfx_rd_expand_quads_scalar(v, quads, first, count, texture, uv_scale);
+}
+
+#endif
+
+#if VGFX_RD_SIMD_NEON
+
+static inline float32x4_t
+_vgfx_rd_neon_load(const VGFX_RD_QuadArrays *quads, const f32 *field, usize i) {
+
+  if (!quads->stride) {
+    return vld1q_f32(&field[i]);
+  }
+
+  const u8 *ptr = (const u8 *)field + i * quads->stride;
+
+  f32 tmp[4] = {
+    *(const f32 *)(ptr),
+    *(const f32 *)(ptr + quads->stride),
+    *(const f32 *)(ptr + quads->stride * 2),
+    *(const f32 *)(ptr + quads->stride * 3),
+  };
+
+  return vld1q_f32(tmp);
+}
+
+static inline uint32x4_t
+_vgfx_rd_neon_unorm16(float32x4_t v) {
+
+  v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+
+  return vcvtq_u32_f32(vmlaq_f32(vdupq_n_f32(0.5f), v, vdupq_n_f32(65535.0f)));
+}
+
+void
+_vgfx_rd_expand_quads_neon(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first,
+                           usize count, u8 texture, const f32 *uv_scale) {
+
+  const usize end = first + count;
+
+  const float32x4_t su = vdupq_n_f32(uv_scale[0]);
+  const float32x4_t sv = vdupq_n_f32(uv_scale[1]);
+
+  usize i = first;
+  for (; i + 4 <= end; i += 4, v += 16) {
+    float32x4_t x0 = _vgfx_rd_neon_load(quads, quads->x, i);
+    float32x4_t y0 = _vgfx_rd_neon_load(quads, quads->y, i);
+    float32x4_t z  = _vgfx_rd_neon_load(quads, quads->z, i);
+    float32x4_t x1 = vaddq_f32(x0, _vgfx_rd_neon_load(quads, quads->w, i));
+    float32x4_t y1 = vaddq_f32(y0, _vgfx_rd_neon_load(quads, quads->h, i));
+
+    float32x4_t tx = vdupq_n_f32(0.0f);
+    float32x4_t ty = vdupq_n_f32(0.0f);
+    float32x4_t tw = su;
+    float32x4_t th = sv;
+
+    if (quads->tex_x) {
+      tx = vmulq_f32(_vgfx_rd_neon_load(quads, quads->tex_x, i), su);
+      ty = vmulq_f32(_vgfx_rd_neon_load(quads, quads->tex_y, i), sv);
+      tw = vmulq_f32(_vgfx_rd_neon_load(quads, quads->tex_w, i), su);
+      th = vmulq_f32(_vgfx_rd_neon_load(quads, quads->tex_h, i), sv);
+    }
+
+    uint32x4_t u0 = _vgfx_rd_neon_unorm16(tx);
+    uint32x4_t u1 = _vgfx_rd_neon_unorm16(vaddq_f32(tx, tw));
+    uint32x4_t vb = vshlq_n_u32(_vgfx_rd_neon_unorm16(vaddq_f32(ty, th)), 16);
+    uint32x4_t vt = vshlq_n_u32(_vgfx_rd_neon_unorm16(ty), 16);
+
+    float32x4_t px[4] = {x0, x1, x0, x1};
+    float32x4_t py[4] = {y0, y0, y1, y1};
+    float32x4_t uv[4] = {
+      vreinterpretq_f32_u32(vorrq_u32(u0, vb)),
+      vreinterpretq_f32_u32(vorrq_u32(u1, vb)),
+      vreinterpretq_f32_u32(vorrq_u32(u0, vt)),
+      vreinterpretq_f32_u32(vorrq_u32(u1, vt)),
+    };
+
+    u32 col[4] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
+    for (usize q = 0; q < 4 && quads->col; ++q) {
+      memcpy(&col[q], _VGFX_RD_QUAD_FIELD(quads, col, i + q), sizeof(u32));
+    }
+
+    // Interleaving store yields `pos` and `tex` of one corner per quad
+    for (usize c = 0; c < 4; ++c) {
+      f32 tmp[16];
+      vst4q_f32(tmp, ((float32x4x4_t){{px[c], py[c], z, uv[c]}}));
+
+      for (usize q = 0; q < 4; ++q) {
+        memcpy(&v[q * 4 + c], &tmp[q * 4], sizeof(f32) * 4);
+        memcpy(v[q * 4 + c].col, &col[q], sizeof(u32));
+        v[q * 4 + c].texture = texture;
+      }
+    }
+  }
+
+  _vgfx_rd_expand_quads_scalar(v, quads, i, end - i, texture, uv_scale);
+}
+
+#else
+
+void
+_vgfx_rd_expand_quads_neon(VGFX_RD_Vertex *v, const VGFX_RD_QuadArrays *quads, usize first,
+                           usize count, u8 texture, const f32 *uv_scale) {
+
+  _vgfx_rd_expand_quads_scalar(v, quads, first, count, texture, uv_scale);
+}
+
+#endif
+
+// =============================================
+//
+//
+// Culling
+//
+//
+// =============================================
+
+// Quads are tested as axis aligned boxes against each plane, a quad is culled
+// once its nearest corner lies behind any of them.
+
+usize
+_vgfx_rd_cull_quads(const VGFX_RD_QuadArrays *quads, usize first, usize count, vec4 *planes, 
+                    u8 *visible) {
+
+  vgfx_rd_simd_isa_get();
+
+  return s_rd_cull_kernel(quads, first, count, planes, visible);
+}
+
+usize
+_vgfx_rd_cull_quads_scalar(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                           vec4 *planes, u8 *visible) {
+
+  usize n = 0;
+
+  for (usize i = 0; i < count; ++i) {
+    const f32 x = *(const f32 *)_VGFX_RD_QUAD_FIELD(quads, x, first + i);
+    const f32 y = *(const f32 *)_VGFX_RD_QUAD_FIELD(quads, y, first + i);
+    const f32 z = *(const f32 *)_VGFX_RD_QUAD_FIELD(quads, z, first + i);
+    const f32 w = *(const f32 *)_VGFX_RD_QUAD_FIELD(quads, w, first + i);
+    const f32 h = *(const f32 *)_VGFX_RD_QUAD_FIELD(quads, h, first + i);
+
+    const f32 cx = x + w * 0.5f;
+    const f32 cy = y + h * 0.5f;
+    const f32 hw = fabsf(w) * 0.5f;
+    const f32 hh = fabsf(h) * 0.5f;
+
+    bool inside = true;
+    for (usize p = 0; p < 6; ++p) {
+      const f32 d = planes[p][0] * cx + planes[p][1] * cy + planes[p][2] * z + planes[p][3] + 
+                    fabsf(planes[p][0]) * hw + fabsf(planes[p][1]) * hh;
+
+      inside &= d >= 0.0f;
+    }
+
+    visible[i] = inside;
+    n         += inside;
+  }
+
+  return n;
+}
+
+#if VGFX_RD_SIMD_X86
+
+usize
+_vgfx_rd_cull_quads_sse2(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                         vec4 *planes, u8 *visible) {
+
+  const usize  end  = first + count;
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 sign = _mm_set1_ps(-0.0f);
+
+  __m128 pl[6][4], pa[6][2];
+  for (usize p = 0; p < 6; ++p) {
+    for (usize c = 0; c < 4; ++c) {
+      pl[p][c] = _mm_set1_ps(planes[p][c]);
+    }
+
+    pa[p][0] = _mm_set1_ps(fabsf(planes[p][0]));
+    pa[p][1] = _mm_set1_ps(fabsf(planes[p][1]));
+  }
+
+  usize n = 0;
+  usize i = first;
+  for (; i + 4 <= end; i += 4) {
+    __m128 hw = _mm_mul_ps(_vgfx_rd_sse2_load(quads, quads->w, i), half);
+    __m128 hh = _mm_mul_ps(_vgfx_rd_sse2_load(quads, quads->h, i), half);
+    __m128 cx = _mm_add_ps(_vgfx_rd_sse2_load(quads, quads->x, i), hw);
+    __m128 cy = _mm_add_ps(_vgfx_rd_sse2_load(quads, quads->y, i), hh);
+    __m128 z  = _vgfx_rd_sse2_load(quads, quads->z, i);
+
+    hw = _mm_andnot_ps(sign, hw);
+    hh = _mm_andnot_ps(sign, hh);
+
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (usize p = 0; p < 6; ++p) {
+      __m128 d = _mm_add_ps(_mm_mul_ps(pl[p][0], cx), _mm_mul_ps(pl[p][1], cy));
+      d = _mm_add_ps(d, _mm_add_ps(_mm_mul_ps(pl[p][2], z), pl[p][3]));
+      d = _mm_add_ps(d, _mm_add_ps(_mm_mul_ps(pa[p][0], hw), _mm_mul_ps(pa[p][1], hh)));
+
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(d, _mm_setzero_ps()));
+    }
+
+    const i32 mask = _mm_movemask_ps(inside);
+    for (usize q = 0; q < 4; ++q) {
+      visible[i - first + q] = (mask >> q) & 1;
+    }
+
+    n += __builtin_popcount(mask);
+  }
+
+  return n + _vgfx_rd_cull_quads_scalar(quads, i, end - i, planes, &visible[i - first]);
+}
+
+__attribute__((target("avx2"))) usize
+_vgfx_rd_cull_quads_avx2(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                         vec4 *planes, u8 *visible) {
+
+  const usize  end  = first + count;
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+
+  __m256 pl[6][4], pa[6][2];
+  for (usize p = 0; p < 6; ++p) {
+    for (usize c = 0; c < 4; ++c) {
+      pl[p][c] = _mm256_set1_ps(planes[p][c]);
+    }
+
+    pa[p][0] = _mm256_set1_ps(fabsf(planes[p][0]));
+    pa[p][1] = _mm256_set1_ps(fabsf(planes[p][1]));
+  }
+
+  usize n = 0;
+  usize i = first;
+  for (; i + 8 <= end; i += 8) {
+    __m256 hw = _mm256_mul_ps(_vgfx_rd_avx2_load(quads, quads->w, i), half);
+    __m256 hh = _mm256_mul_ps(_vgfx_rd_avx2_load(quads, quads->h, i), half);
+    __m256 cx = _mm256_add_ps(_vgfx_rd_avx2_load(quads, quads->x, i), hw);
+    __m256 cy = _mm256_add_ps(_vgfx_rd_avx2_load(quads, quads->y, i), hh);
+    __m256 z  = _vgfx_rd_avx2_load(quads, quads->z, i);
+
+    hw = _mm256_andnot_ps(sign, hw);
+    hh = _mm256_andnot_ps(sign, hh);
+
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (usize p = 0; p < 6; ++p) {
+      __m256 d = _mm256_add_ps(_mm256_mul_ps(pl[p][0], cx), _mm256_mul_ps(pl[p][1], cy));
+      d = _mm256_add_ps(d, _mm256_add_ps(_mm256_mul_ps(pl[p][2], z), pl[p][3]));
+      d = _mm256_add_ps(
+        d, _mm256_add_ps(_mm256_mul_ps(pa[p][0], hw), _mm256_mul_ps(pa[p][1], hh)));
+
+      inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GE_OQ));
+    }
+
+    const i32 mask = _mm256_movemask_ps(inside);
+    for (usize q = 0; q < 8; ++q) {
+      visible[i - first + q] = (mask >> q) & 1;
+    }
+
+    n += __builtin_popcount(mask);
+  }
+
+  return n + _vgfx_rd_cull_quads_scalar(quads, i, end - i, planes, &visible[i - first]);
+}
+
+#else
+
+usize
+_vgfx_rd_cull_quads_sse2(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                         vec4 *planes, u8 *visible) {
+
+  return _vgfx_rd_cull_quads_scalar(quads, first, count, planes, visible);
+}
+
+usize
+_vgfx_rd_cull_quads_avx2(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                         vec4 *planes, u8 *visible) {
+
+  return _vgfx_rd_cull_quads_scalar(quads, first, count, planes, visible);
+}
+
+#endif
+
+#if VGFX_RD_SIMD_NEON
+
+usize
+_vgfx_rd_cull_quads_neon(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                         vec4 *planes, u8 *visible) {
+
+  const usize       end  = first + count;
+  const float32x4_t half = vdupq_n_f32(0.5f);
+
+  usize n = 0;
+  usize i = first;
+  for (; i + 4 <= end; i += 4) {
+    float32x4_t hw = vmulq_f32(_vgfx_rd_neon_load(quads, quads->w, i), half);
+    float32x4_t hh = vmulq_f32(_vgfx_rd_neon_load(quads, quads->h, i), half);
+    float32x4_t cx = vaddq_f32(_vgfx_rd_neon_load(quads, quads->x, i), hw);
+    float32x4_t cy = vaddq_f32(_vgfx_rd_neon_load(quads, quads->y, i), hh);
+    float32x4_t z  = _vgfx_rd_neon_load(quads, quads->z, i);
+
+    hw = vabsq_f32(hw);
+    hh = vabsq_f32(hh);
+
+    uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+    for (usize p = 0; p < 6; ++p) {
+      float32x4_t d = vdupq_n_f32(planes[p][3]);
+      d = vmlaq_n_f32(d, cx, planes[p][0]);
+      d = vmlaq_n_f32(d, cy, planes[p][1]);
+      d = vmlaq_n_f32(d, z,  planes[p][2]);
+      d = vmlaq_n_f32(d, hw, fabsf(planes[p][0]));
+      d = vmlaq_n_f32(d, hh, fabsf(planes[p][1]));
+
+      inside = vandq_u32(inside, vcgeq_f32(d, vdupq_n_f32(0.0f)));
+    }
+
+    u32 lanes[4];
+    vst1q_u32(lanes, inside);
+
+    for (usize q = 0; q < 4; ++q) {
+      visible[i - first + q] = lanes[q] & 1;
+      n                     += lanes[q] & 1;
+    }
+  }
+
+  return n + _vgfx_rd_cull_quads_scalar(quads, i, end - i, planes, &visible[i - first]);
+}
+
+#else
+
+usize
+_vgfx_rd_cull_quads_neon(const VGFX_RD_QuadArrays *quads, usize first, usize count, 
+                         vec4 *planes, u8 *visible) {
+
+  return _vgfx_rd_cull_quads_scalar(quads, first, count, planes, visible);
+}
+
+#endif
@@ -0,0 +1,387 @@
+#include "vgfx/asset.h"
+#include "vgfx/core.h"
+#include "vgfx/fs.h"
+#include "vgfx/gl.h"
+
+// Bakes the assets listed in a manifest into a single archive which the
+// asset server can mount. One entry per line, `#` starts a comment:
+//
+//   file    res/shader/base.vert
+//   texture res/bunny.png [array] [mipmaps]
+//   font    res/font/Roboto-Regular.ttf <size> <first> <last>
+//
+// Paths are stored as written, they have to match the ones passed to the loaders.
+
+#define PACK_MAX_LINE 1024
+
+typedef struct Blob Blob;
+struct Blob {
+  u8   *data;
+  usize len;
+  usize cap;
+};
+
+typedef struct Pack Pack;
+struct Pack {
+  VSTD_Vector(VGFX_AS_PackEntry) entries;
+  Blob                           keys;
+  Blob                           payload;
+};
+
+usize blob_reserve(Blob *blob, usize size) {
+
+  // Payloads start aligned, the archive's sections are aligned as well
+  const usize offset = VGFX_AS_PACK_ALIGN(blob->len);
+
+  if (offset + size > blob->cap) {
+    usize cap = (blob->cap) ? blob->cap : 4096;
+    while (cap < offset + size) {
+      cap <<= 1;
+    }
+
+    blob->data = (u8 *)realloc(blob->data, cap);
+    VGFX_ASSERT_NON_NULL(blob->data);
+
+    blob->cap = cap;
+  }
+
+  memset(blob->data + blob->len, 0, offset + size - blob->len);
+  blob->len = offset + size;
+
+  return offset;
+}
+
+usize blob_push(Blob *blob, const void *data, usize size) {
+
+  const usize offset = blob_reserve(blob, size);
+
+  if (size) {
+    memcpy(blob->data + offset, data, size);
+  }
+
+  return offset;
+}
+
+VGFX_AS_PackEntry *pack_entry(Pack *pack, VGFX_AS_PackKind kind, const char *path, 
+                              VGFX_AS_AssetDesc *desc) {
+
+  VSTD_String key = _vgfx_as_archive_key(kind, path, desc);
+  const u64 hash  = _vgfx_as_cache_hash(key.ptr);
+
+  for (usize i = 0; i < pack->entries.len; ++i) {
+    VGFX_AS_PackEntry *other = &vstd_vector_get(VGFX_AS_PackEntry, pack->entries, i);
+
+    if (other->hash == hash && !strcmp((const char *)pack->keys.data + other->key_offset, key.ptr)) {
+      fprintf(stderr, "vgfx-pack: skipping duplicate entry, `%s`.\n", key.ptr);
+
+      vstd_string_free(&key);
+      return NULL;
+    }
+  }
+
+  VGFX_AS_PackEntry entry = {
+    .hash = hash,
+    .key_offset = blob_push(&pack->keys, key.ptr, strlen(key.ptr) + 1),
+    .kind = kind,
+  };
+
+  vstd_string_free(&key);
+
+  vstd_vector_push(VGFX_AS_PackEntry, (&pack->entries), entry);
+
+  return &vstd_vector_get(VGFX_AS_PackEntry, pack->entries, pack->entries.len - 1);
+}
+
+bool pack_file(Pack *pack, const char *path) {
+
+  VGFX_FS_File file;
+  if (!vgfx_fs_map(path, &file)) {
+    fprintf(stderr, "vgfx-pack: failed to read, `%s`.\n", path);
+    return false;
+  }
+
+  VGFX_AS_PackEntry *entry = pack_entry(pack, VGFX_AS_PACK_KIND_FILE, path, NULL);
+
+  if (entry) {
+    entry->offset = blob_push(&pack->payload, file.data, file.size);
+    entry->size   = file.size;
+  }
+
+  vgfx_fs_unmap(&file);
+
+  return true;
+}
+
+void pack_downsample(const u8 *src, i32 sw, i32 sh, u8 *dst, i32 dw, i32 dh, i32 channel) {
+
+  // 2x2 box filter, odd edges clamp onto the last texel
+  for (i32 y = 0; y < dh; ++y) {
+    const i32 y0 = (2 * y < sh) ? 2 * y : sh - 1;
+    const i32 y1 = (2 * y + 1 < sh) ? 2 * y + 1 : sh - 1;
+
+    for (i32 x = 0; x < dw; ++x) {
+      const i32 x0 = (2 * x < sw) ? 2 * x : sw - 1;
+      const i32 x1 = (2 * x + 1 < sw) ? 2 * x + 1 : sw - 1;
+
+      for (i32 c = 0; c < channel; ++c) {
+        const u32 sum = (u32)src[((usize)y0 * sw + x0) * channel + c] +
+                        (u32)src[((usize)y0 * sw + x1) * channel + c] +
+                        (u32)src[((usize)y1 * sw + x0) * channel + c] +
+                        (u32)src[((usize)y1 * sw + x1) * channel + c];
+
+        dst[((usize)y * dw + x) * channel + c] = (u8)((sum + 2) / 4);
+      }
+    }
+  }
+}
+
+bool pack_texture(Pack *pack, const char *path, bool array, bool mipmaps) {
+
+  VGFX_AS_AssetDesc desc = {
+    .type = VGFX_ASSET_TYPE_TEXTURE,
+    .texture_path = path,
+    .texture_array = array,
+  };
+
+  _VGFX_AS_Decoded decoded;
+  if (!_vgfx_as_decode(&desc, &decoded)) {
+    fprintf(stderr, "vgfx-pack: failed to decode texture, `%s`.\n", path);
+    return false;
+  }
+
+  VGFX_AS_PackEntry *entry = pack_entry(pack, VGFX_AS_PACK_KIND_TEXTURE, path, &desc);
+
+  if (entry) {
+    // Array layers share one mip chain which is regenerated per upload
+    const i32 w = decoded.width;
+    const i32 h = decoded.height;
+    const i32 c = decoded.channel;
+    const i32 levels = (mipmaps && !array) ? _vgfx_gl_texture_levels(w, h) : 1;
+
+    entry->width   = w;
+    entry->height  = h;
+    entry->channel = c;
+    entry->levels  = levels;
+    entry->opaque  = decoded.opaque;
+    entry->size    = _vgfx_as_archive_texture_size(w, h, c, levels);
+    entry->offset  = blob_reserve(&pack->payload, entry->size);
+
+    u8 *dst = pack->payload.data + entry->offset;
+    memcpy(dst, decoded.pixels, (usize)w * h * c);
+
+    for (i32 i = 1; i < levels; ++i) {
+      const i32 sw = (w >> (i - 1)) ? (w >> (i - 1)) : 1;
+      const i32 sh = (h >> (i - 1)) ? (h >> (i - 1)) : 1;
+      const i32 dw = (w >> i) ? (w >> i) : 1;
+      const i32 dh = (h >> i) ? (h >> i) : 1;
+
+      pack_downsample(dst, sw, sh, dst + (usize)sw * sh * c, dw, dh, c);
+      dst += (usize)sw * sh * c;
+    }
+  }
+
+  _vgfx_as_decoded_free(VGFX_ASSET_TYPE_TEXTURE, &decoded);
+
+  return true;
+}
+
+bool pack_font(Pack *pack, const char *path, u32 size, u32 first, u32 last) {
+
+  VGFX_AS_AssetDesc desc = {
+    .type = VGFX_ASSET_TYPE_FONT,
+    .font_path = path,
+    .font_size = size,
+    .font_range = {first, last},
+  };
+
+  _VGFX_AS_Decoded decoded;
+  if (!size || !_vgfx_as_decode(&desc, &decoded)) {
+    fprintf(stderr, "vgfx-pack: failed to rasterize font, `%s`.\n", path);
+    return false;
+  }
+
+  VGFX_AS_PackEntry *entry = pack_entry(pack, VGFX_AS_PACK_KIND_FONT, path, &desc);
+
+  if (entry) {
+    const usize count  = last - first;
+    const usize glyphs = VGFX_AS_PACK_ALIGN(count * sizeof(_VGFX_AS_Glyph));
+    const usize atlas  = (usize)decoded.atlas_width * decoded.atlas_height;
+
+    entry->atlas_width          = decoded.atlas_width;
+    entry->atlas_height         = decoded.atlas_height;
+    entry->glyph_count          = (u32)count;
+    entry->average_glyph_height = decoded.average_glyph_height;
+    entry->size                 = glyphs + atlas;
+    entry->offset               = blob_reserve(&pack->payload, entry->size);
+
+    u8 *dst = pack->payload.data + entry->offset;
+    memcpy(dst, decoded.glyphs, count * sizeof(_VGFX_AS_Glyph));
+    memcpy(dst + glyphs, decoded.atlas, atlas);
+  }
+
+  _vgfx_as_decoded_free(VGFX_ASSET_TYPE_FONT, &decoded);
+
+  return true;
+}
+
+bool pack_manifest(Pack *pack, const char *path) {
+
+  FILE *manifest = fopen(path, "r");
+  if (!manifest) {
+    fprintf(stderr, "vgfx-pack: failed to open manifest, `%s`.\n", path);
+    return false;
+  }
+
+  char line[PACK_MAX_LINE];
+  bool success = true;
+
+  for (u32 number = 1; success && fgets(line, sizeof(line), manifest); ++number) {
+    char *comment = strchr(line, '#');
+    if (comment) {
+      *comment = '\0';
+    }
+
+    char kind[16], file[512], opts[2][16] = {{0}};
+    u32  size, first, last;
+
+    const i32 count = sscanf(line, "%15s %511s %15s %15s", kind, file, opts[0], opts[1]);
+
+    if (count <= 0) {
+      continue;
+    }
+
+    if (count >= 2 && !strcmp(kind, "file")) {
+      success = pack_file(pack, file);
+    } else if (count >= 2 && !strcmp(kind, "texture")) {
+      bool array = false, mipmaps = false;
+
+      for (i32 i = 0; i < count - 2; ++i) {
+        array   |= !strcmp(opts[i], "array");
+        mipmaps |= !strcmp(opts[i], "mipmaps");
+      }
+
+      success = pack_texture(pack, file, array, mipmaps);
+    } else if (!strcmp(kind, "font") && 
+               sscanf(line, "%*s %511s %u %u %u", file, &size, &first, &last) == 4 &&
+               first < last) {
+      success = pack_font(pack, file, size, first, last);
+    } else {
+      fprintf(stderr, "vgfx-pack: %s:%u: invalid entry.\n", path, number);
+      success = false;
+    }
+  }
+
+  fclose(manifest);
+
+  return success;
+}
+
+void pack_pad(FILE *out, usize offset) {
+
+  static const u8 zeros[VGFX_AS_PACK_ALIGNMENT] = {0};
+
+  const long pos = ftell(out);
+  if (pos >= 0 && (usize)pos < offset) {
+    fwrite(zeros, 1, offset - (usize)pos, out);
+  }
+}
+
+bool pack_write(Pack *pack, const char *path) {
+
+  const u32 count = (u32)pack->entries.len;
+
+  // Keep the index at most half full
+  u32 bucket_count = VGFX_AS_PACK_ALIGNMENT;
+  while (bucket_count < 2 * count) {
+    bucket_count <<= 1;
+  }
+
+  u32 *buckets = (u32 *)calloc(bucket_count, sizeof(u32));
+  VGFX_ASSERT_NON_NULL(buckets);
+
+  for (u32 i = 0; i < count; ++i) {
+    const u64 hash = vstd_vector_get(VGFX_AS_PackEntry, pack->entries, i).hash;
+
+    u32 b = (u32)hash & (bucket_count - 1);
+    while (buckets[b]) {
+      b = (b + 1) & (bucket_count - 1);
+    }
+
+    buckets[b] = i + 1;
+  }
+
+  // Header, entries, buckets, keys and payloads follow each other
+  VGFX_AS_PackHeader header = {
+    .magic = VGFX_AS_PACK_MAGIC,
+    .version = VGFX_AS_PACK_VERSION,
+    .glyph_size = sizeof(_VGFX_AS_Glyph),
+    .entry_count = count,
+    .bucket_count = bucket_count,
+  };
+
+  header.entries_offset = VGFX_AS_PACK_ALIGN(sizeof(VGFX_AS_PackHeader));
+  header.buckets_offset = VGFX_AS_PACK_ALIGN(
+    header.entries_offset + count * sizeof(VGFX_AS_PackEntry));
+
+  const usize keys_offset    = VGFX_AS_PACK_ALIGN(header.buckets_offset + bucket_count * sizeof(u32));
+  const usize payload_offset = VGFX_AS_PACK_ALIGN(keys_offset + pack->keys.len);
+
+  vstd_vector_iter(VGFX_AS_PackEntry, pack->entries, {
+    _$iter->key_offset += keys_offset;
+    _$iter->offset     += payload_offset;
+  });
+
+  FILE *out = fopen(path, "wb");
+  if (!out) {
+    fprintf(stderr, "vgfx-pack: failed to create, `%s`.\n", path);
+
+    free(buckets);
+    return false;
+  }
+
+  fwrite(&header, sizeof(header), 1, out);
+
+  pack_pad(out, header.entries_offset);
+  if (count) {
+    fwrite(&vstd_vector_get(VGFX_AS_PackEntry, pack->entries, 0), sizeof(VGFX_AS_PackEntry), count, out);
+  }
+
+  pack_pad(out, header.buckets_offset);
+  fwrite(buckets, sizeof(u32), bucket_count, out);
+
+  pack_pad(out, keys_offset);
+  fwrite(pack->keys.data, 1, pack->keys.len, out);
+
+  pack_pad(out, payload_offset);
+  fwrite(pack->payload.data, 1, pack->payload.len, out);
+
+  const bool success = !ferror(out);
+
+  fclose(out);
+  free(buckets);
+
+  printf("vgfx-pack: %u entries, %zu bytes, `%s`\n",
+         count, payload_offset + pack->payload.len, path);
+
+  return success;
+}
+
+int main(i32 argc, char *argv[]) {
+
+  if (argc != 3) {
+    fprintf(stderr, "usage: vgfx-pack <manifest> <archive>\n");
+    return 1;
+  }
+
+  Pack pack = {
+    .entries = vstd_vector_new(VGFX_AS_PackEntry),
+  };
+
+  const bool success = pack_manifest(&pack, argv[1]) && pack_write(&pack, argv[2]);
+
+  vstd_vector_free(VGFX_AS_PackEntry, (&pack.entries));
+  free(pack.keys.data);
+  free(pack.payload.data);
+
+  return (success) ? 0 : 1;
+}